@@ -0,0 +1,177 @@
+#ifdef CT_BASE_64_HPP
+
+namespace impl
+{
+namespace rt
+{
+    //////////// Batch Encoder ////////////
+
+    // messages are copied back to back into a staging block, each one zero-filled to whole groups, so a
+    // single kernel call covers many of them; the kernel output lands in the arena as it is, since every
+    // message takes 4 * ceil(n / 3) chars there, and only the last 1-2 chars of a short group get fixed
+    static constexpr size_t batch_block = 3072;
+
+    // the chars encoded for [first, last), all staged: '=' for the zero fill, or, without padding,
+    // the messages moved down over it; returns the end of the output
+    inline size_t encode_fixup(const Slice* in, size_t first, size_t last, bool padding, char* arena, size_t pos,
+                               size_t* offsets) {
+        size_t src = pos;
+        for (size_t m = first; m < last; ++m) {
+            const size_t n = in[m].size, chars = encoded_length(6, n, true), fill = (3 - n % 3) % 3;
+            offsets[m] = pos;
+            if (padding) {
+                for (size_t j = chars - fill; j < chars; ++j)
+                    arena[pos + j] = '=';
+                pos += chars;
+            } else {
+                if (pos != src)
+                    std::memmove(arena + pos, arena + src, chars - fill);
+                pos += chars - fill;
+            }
+            src += chars;
+        }
+        return pos;
+    }
+
+    inline size_t encode_batch(const Kernels& k, const Tables& t, bool padding, const Slice* in, size_t count,
+                               char* arena, size_t* offsets) {
+        uint8_t stage[batch_block];
+        size_t pos = 0, staged = 0, first = 0;
+        for (size_t m = 0; m <= count; ++m) {
+            const size_t n = m < count ? in[m].size : 0;
+            const size_t whole = (n + 2) / 3 * 3;
+            if (m == count || staged + whole > batch_block) {
+                k.encode(stage, staged, arena + pos, t);
+                pos = encode_fixup(in, first, m, padding, arena, pos, offsets);
+                staged = 0;
+                first = m;
+            }
+            if (m == count)
+                break;
+            if (whole > batch_block) {
+                // too large to be worth staging
+                offsets[m] = pos;
+                pos += encode(k, t, padding, static_cast<const uint8_t*>(in[m].data), n, arena + pos);
+                first = m + 1;
+                continue;
+            }
+            if (n)
+                std::memcpy(stage + staged, in[m].data, n);
+            std::memset(stage + staged + n, 0, whole - n);
+            staged += whole;
+        }
+        offsets[count] = pos;
+        return pos;
+    }
+
+    //////////// Batch Decoder ////////////
+
+    // the messages of a valid length are staged back to back, their '=' replaced by dict[0] and their
+    // short last group completed with it, so that one kernel call decodes many of them; the exact bytes
+    // of each one are then copied to the arena. The messages the kernel stops in, and those of a bad
+    // length, are decoded again on their own for their error offset
+    class BatchDecoder {
+    public:
+        BatchDecoder(const Kernels& k, const Tables& t, bool padding, const Slice* in, uint8_t* arena,
+                     size_t* offsets, size_t* errors)
+            : k(k), t(t), padding(padding), in(in), arena(arena), offsets(offsets), errors(errors) { }
+
+        void add(size_t m) {
+            const char* b64 = static_cast<const char*>(in[m].data);
+            const size_t n = in[m].size, whole = (n + 3) & ~size_t(3);
+            if ((padding ? n % 4 != 0 : n % 4 == 1) || whole > batch_block) {
+                flush();
+                single(m);
+                return;
+            }
+            if (chars + whole > batch_block || nstaged == max_staged)
+                flush();
+            Staged& g = staged[nstaged++];
+            g.message = m;
+            g.at = chars;
+            g.chars = whole;
+            if (n)
+                std::memcpy(stage + chars, b64, n);
+            if (padding) {
+                const size_t pad = (n && b64[n - 1] == '=') ? (b64[n - 2] == '=' ? 2 : 1) : 0;
+                std::memset(stage + chars + n - pad, t.dict[0], pad);
+                g.bytes = n / 4 * 3 - pad;
+            } else {
+                std::memset(stage + chars + n, t.dict[0], whole - n);
+                g.bytes = n / 4 * 3 + (n % 4 ? n % 4 - 1 : 0);
+            }
+            chars += whole;
+        }
+
+        // returns the number of bad messages
+        size_t finish(size_t count) {
+            flush();
+            offsets[count] = pos;
+            return failed;
+        }
+
+    private:
+        struct Staged {
+            size_t message, at, chars, bytes;
+        };
+
+        static constexpr size_t max_staged = batch_block / 16;
+
+        void flush() {
+            size_t done = 0, s = 0;
+            while (s < nstaged) {
+                const size_t used = done + k.decode(stage + done, chars - done, bytes + done / 4 * 3, t);
+                for (; s < nstaged && staged[s].at + staged[s].chars <= used; ++s) {
+                    const Staged& g = staged[s];
+                    offsets[g.message] = pos;
+                    std::memcpy(arena + pos, bytes + g.at / 4 * 3, g.bytes);
+                    pos += g.bytes;
+                    if (errors)
+                        errors[g.message] = npos;
+                }
+                if (s == nstaged)
+                    break;
+                single(staged[s++].message);
+                done = s < nstaged ? staged[s].at : chars;
+            }
+            nstaged = 0;
+            chars = 0;
+        }
+
+        void single(size_t m) {
+            size_t e = npos;
+            const size_t size = decode(k, t, padding, static_cast<const char*>(in[m].data), in[m].size,
+                                       arena + pos, &e);
+            offsets[m] = pos;
+            if (size == npos)
+                ++failed;
+            else
+                pos += size;
+            if (errors)
+                errors[m] = size == npos ? e : npos;
+        }
+
+        const Kernels& k;
+        const Tables& t;
+        const bool padding;
+        const Slice* in;
+        uint8_t* arena;
+        size_t* offsets;
+        size_t* errors;
+        size_t pos = 0, failed = 0, chars = 0, nstaged = 0;
+        char stage[batch_block];
+        uint8_t bytes[batch_block / 4 * 3];
+        Staged staged[max_staged];
+    };
+
+    inline size_t decode_batch(const Kernels& k, const Tables& t, bool padding, const Slice* in, size_t count,
+                               uint8_t* arena, size_t* offsets, size_t* errors) {
+        BatchDecoder batch(k, t, padding, in, arena, offsets, errors);
+        for (size_t m = 0; m < count; ++m)
+            batch.add(m);
+        return batch.finish(count);
+    }
+}
+}
+
+#endif // CT_BASE_64_HPP
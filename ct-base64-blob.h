@@ -0,0 +1,50 @@
+#ifdef CT_BASE_64_HPP
+
+//////////// Embedded Blob ////////////
+
+// a Base64 literal kept encoded in read-only data and decoded by the runtime codec on first access,
+// into a static buffer: only the blobs in use cost decode work, and nothing is decoded at compile time.
+// The first access goes through a once flag, the later ones are a single acquire load
+template <class Codec, char... encoded>
+class embedded_blob {
+    static_assert(impl::checks::is_encoding_v<typename Codec::alphabet_type, Codec::padding, encoded...>,
+                  "Input string is not a valid base 64 encoding");
+
+public:
+    // exact payload size
+    static constexpr size_t size() { return impl::decoded_size<typename Codec::alphabet_type, encoded...>(); }
+
+    static const uint8_t* data() {
+        if (ready.load(std::memory_order_acquire))
+            return buffer;
+        std::call_once(once, [] {
+            Codec::decode(ct::string<encoded...>::data, sizeof...(encoded), buffer);
+            ready.store(true, std::memory_order_release);
+        });
+        return buffer;
+    }
+
+    const uint8_t* begin() const { return data(); }
+    const uint8_t* end() const { return data() + size(); }
+
+private:
+    static uint8_t buffer[size() ? size() : 1];
+    static std::once_flag once;
+    static std::atomic<bool> ready;
+};
+
+template <class Codec, char... encoded>
+uint8_t embedded_blob<Codec, encoded...>::buffer[size() ? size() : 1];
+
+template <class Codec, char... encoded>
+std::once_flag embedded_blob<Codec, encoded...>::once;
+
+template <class Codec, char... encoded>
+std::atomic<bool> embedded_blob<Codec, encoded...>::ready{false};
+
+template <class Codec = Base64, char... encoded>
+constexpr embedded_blob<Codec, encoded...> make_embedded_blob(ct::string<encoded...>) {
+    return {};
+}
+
+#endif // CT_BASE_64_HPP
@@ -0,0 +1,641 @@
+/**
+ * Compile-time lib
+ * @file    ct-base64-cli.cpp
+ * @brief   Base64 file encoder/decoder on top of the ct-base64 runtime codec (POSIX)
+ * @author  Douglas Oliveira
+ * @date    2026-10-16
+ *
+ * The input file is mapped read-only and the output file is mapped shared, after being sized with
+ * ftruncate, so the codec reads and writes the pages directly: no read/write copies, no stdio buffers.
+ *
+ * Pipes, '-' (stdin/stdout) and the files picked with -p go through a pipeline instead: several
+ * fixed-size buffers are kept in flight through io_uring reads and writes (raw syscalls, no liburing),
+ * and the streaming codec runs on each filled buffer in order, carrying the partial groups over to the
+ * next one, so the I/O overlaps with the transcoding. Without io_uring (older kernels, seccomp), the
+ * same pipeline runs on blocking reads and writes.
+ *
+ * build: g++ -std=c++14 -O2 -pthread ct-base64-cli.cpp -o ct-base64
+ * usage: ct-base64 [-d] [-a legacy|standard|url] [-u] [-w cols] [-c] [-j threads] [-p] <input> <output>
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <deque>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#include "ct-base64-runtime.hpp"
+
+namespace
+{
+
+struct Options {
+    bool decode = false;
+    const char* alphabet = "standard";
+    bool padding = true;
+    // chars per line when encoding, 0 for a single line (a multiple of 4, so lines hold whole groups)
+    size_t cols = 76;
+    bool crlf = false;
+    ct::Parallel parallel;
+    // through the pipeline even for regular files
+    bool pipeline = false;
+    // pipeline buffers, and how many of them are in flight
+    size_t block = size_t(1) << 20;
+    unsigned depth = 8;
+    const char* input = nullptr;
+    const char* output = nullptr;
+};
+
+int usage(const char* name) {
+    std::fprintf(stderr,
+        "usage: %s [-d] [-a legacy|standard|url] [-u] [-w cols] [-c] [-j threads] [-p] <input> <output>\n"
+        "  -d          decode (spaces, tabs and line breaks in the input are skipped)\n"
+        "  -a name     alphabet: legacy (ct::Base64), standard (RFC 4648, default) or url (base64url)\n"
+        "  -u          no padding\n"
+        "  -w cols     wrap encoded lines after cols chars, a multiple of 4 (default 76, 0 to disable)\n"
+        "  -c          end the lines with CRLF instead of LF\n"
+        "  -j threads  threads for decoding and unwrapped encoding (default: all cores, 1 to disable)\n"
+        "  -p          stream through the io_uring pipeline instead of mapping the files\n"
+        "              (always for pipes; '-' stands for stdin or stdout)\n",
+        name);
+    return 2;
+}
+
+int fail(const char* what, const char* path) {
+    std::fprintf(stderr, "ct-base64: %s '%s': %s\n", what, path, std::strerror(errno));
+    return 1;
+}
+
+// true if @p path is the file open as @p fd: opening it for output would truncate the input
+bool same_file(int fd, const char* path) {
+    struct stat a, b;
+    return fstat(fd, &a) == 0 && stat(path, &b) == 0 && a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+}
+
+int refuse_same_file(const char* path) {
+    std::fprintf(stderr, "ct-base64: '%s' is both the input and the output\n", path);
+    return 1;
+}
+
+// a read-only (input) or shared writable (output) mapping of a whole file, none for empty files
+class Mapping {
+public:
+    ~Mapping() {
+        if (data)
+            munmap(data, size);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    bool open_input(const char* path) {
+        fd = ::open(path, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0)
+            return false;
+        size = size_t(st.st_size);
+        if (size == 0)
+            return true;
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+            return false;
+        }
+        madvise(data, size, MADV_SEQUENTIAL);
+        return true;
+    }
+
+    bool open_output(const char* path, size_t length) {
+        fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, off_t(length)) != 0)
+            return false;
+        size = length;
+        if (size == 0)
+            return true;
+        data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    // true if @p path is the mapped file
+    bool is(const char* path) const { return fd >= 0 && same_file(fd, path); }
+
+    // unmaps the file and cuts it to @p length bytes
+    bool truncate(size_t length) {
+        if (data && munmap(data, size) != 0)
+            return false;
+        data = nullptr;
+        size = length;
+        return ftruncate(fd, off_t(length)) == 0;
+    }
+
+    void* data = nullptr;
+    size_t size = 0;
+
+private:
+    int fd = -1;
+};
+
+template <class Codec>
+int encode(const Options& opt, Mapping& in, Mapping& out) {
+    const uint8_t* src = static_cast<const uint8_t*>(in.data);
+    const size_t n = in.size;
+    const ct::LineWrap wrap = { opt.cols, opt.crlf };
+
+    if (!out.open_output(opt.output, Codec::encoded_size(n, wrap)))
+        return fail("cannot map", opt.output);
+    char* dst = static_cast<char*>(out.data);
+
+    if (opt.cols == 0)
+        Codec::encode(src, n, dst, opt.parallel);
+    else
+        Codec::encode(src, n, dst, wrap);
+    return 0;
+}
+
+template <class Codec>
+int decode(const Options& opt, Mapping& in, Mapping& out) {
+    const char* src = static_cast<const char*>(in.data);
+    const size_t n = in.size;
+    // sized for the worst case, cut to the decoded size at the end
+    if (!out.open_output(opt.output, (n + 3) / 4 * 3))
+        return fail("cannot map", opt.output);
+    uint8_t* dst = static_cast<uint8_t*>(out.data);
+
+    // wrapped or not, the whitespace is skipped on the way
+    size_t error = 0;
+    const size_t size = Codec::decode_relaxed(src, n, dst, &error, opt.parallel);
+    if (size == Codec::npos) {
+        std::fprintf(stderr, "ct-base64: invalid input '%s' at char %zu\n", opt.input, error);
+        return 1;
+    }
+    if (!out.truncate(size))
+        return fail("cannot resize", opt.output);
+    return 0;
+}
+
+// a minimal io_uring, reads and writes only; without io_uring the requests are carried out on the
+// spot with blocking calls, their results queued as the completions
+class Ring {
+public:
+    ~Ring() {
+        close();
+    }
+
+    // tears the ring down: its requests in flight are cancelled and waited for, the later ones are
+    // carried out with blocking calls
+    void close() {
+        if (sqes)
+            munmap(sqes, sqes_size);
+        if (cq_ring && cq_ring != sq_ring)
+            munmap(cq_ring, cq_size);
+        if (sq_ring)
+            munmap(sq_ring, sq_size);
+        if (fd >= 0)
+            ::close(fd);
+        sqes = nullptr;
+        sq_ring = cq_ring = nullptr;
+        fd = -1;
+        ready = false;
+    }
+
+    // false when io_uring is not available: the blocking fallback is used
+    bool open(unsigned entries) {
+#if defined(__linux__) && defined(IORING_FEAT_RW_CUR_POS)
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        const long ring = syscall(__NR_io_uring_setup, entries, &p);
+        if (ring < 0)
+            return false;
+        fd = int(ring);
+        // IORING_OP_READ and IORING_OP_WRITE came with this feature (Linux 5.6), the rings of older
+        // kernels fail every request with -EINVAL
+        if (!(p.features & IORING_FEAT_RW_CUR_POS))
+            return false;
+        sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+            sq_size = cq_size = std::max(sq_size, cq_size);
+        sq_ring = map(sq_size, IORING_OFF_SQ_RING);
+        cq_ring = single ? sq_ring : map(cq_size, IORING_OFF_CQ_RING);
+        sqes_size = p.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(map(sqes_size, IORING_OFF_SQES));
+        if (!sq_ring || !cq_ring || !sqes)
+            return false;
+        char* sq = static_cast<char*>(sq_ring);
+        sq_head = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_entries = p.sq_entries;
+        sq_mask = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        char* cq = static_cast<char*>(cq_ring);
+        cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        ready = true;
+        return true;
+#else
+        static_cast<void>(entries);
+        return false;
+#endif
+    }
+
+    // queues a read or a write of [buf, buf+len) at @p offset (-1: at the file position), its
+    // completion tagged with @p tag; false if the submission queue has no room, even once the queued
+    // requests are handed over
+    bool prepare(bool write, int file, void* buf, size_t len, off_t offset, uint64_t tag) {
+#ifdef __linux__
+        if (ready) {
+            if (full() && (!enter(0) || full()))
+                return false;
+            const unsigned tail = *sq_tail;
+            const unsigned i = tail & sq_mask;
+            io_uring_sqe& e = sqes[i];
+            std::memset(&e, 0, sizeof(e));
+            e.opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+            e.fd = file;
+            e.addr = uint64_t(reinterpret_cast<uintptr_t>(buf));
+            e.len = unsigned(len);
+            e.off = offset < 0 ? uint64_t(-1) : uint64_t(offset);
+            e.user_data = tag;
+            sq_array[i] = i;
+            __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+            ++queued;
+            return true;
+        }
+#endif
+        ssize_t n;
+        if (write)
+            n = offset < 0 ? ::write(file, buf, len) : pwrite(file, buf, len, offset);
+        else
+            n = offset < 0 ? ::read(file, buf, len) : pread(file, buf, len, offset);
+        done.push_back(Completion{ tag, n < 0 ? -long(errno) : long(n) });
+        return true;
+    }
+
+    // hands the queued requests over to the kernel, without waiting
+    bool submit() {
+        return enter(0);
+    }
+
+    // takes the next completion, waiting for one if none is there yet (through EINTR): its tag, and the
+    // bytes read or written or -errno; false if nothing can complete
+    bool next(uint64_t& tag, long& result) {
+#ifdef __linux__
+        while (ready) {
+            const unsigned head = *cq_head;
+            if (head != __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe& c = cqes[head & cq_mask];
+                tag = c.user_data;
+                result = c.res;
+                __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            if (!enter(1))
+                return false;
+        }
+#endif
+        if (done.empty())
+            return false;
+        tag = done.front().tag;
+        result = done.front().result;
+        done.pop_front();
+        return true;
+    }
+
+    bool uring() const { return ready; }
+
+private:
+    struct Completion {
+        uint64_t tag;
+        long result;
+    };
+
+#ifdef __linux__
+    // the kernel moves the head as it takes the entries
+    bool full() const {
+        return *sq_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries;
+    }
+
+    void* map(size_t size, off_t offset) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    bool enter(unsigned wait) {
+        while (ready && (queued || wait)) {
+            const long n = syscall(__NR_io_uring_enter, fd, queued, wait, wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (n < 0 && errno != EINTR)
+                return false;
+            queued -= n < 0 ? 0 : unsigned(n);
+            if (n >= 0 && queued == 0)
+                break;
+        }
+        return true;
+    }
+#else
+    bool enter(unsigned) { return true; }
+#endif
+
+    int fd = -1;
+    bool ready = false;
+    void* sq_ring = nullptr;
+    void* cq_ring = nullptr;
+    size_t sq_size = 0, cq_size = 0, sqes_size = 0;
+#ifdef __linux__
+    io_uring_sqe* sqes = nullptr;
+    io_uring_cqe* cqes = nullptr;
+#else
+    void* sqes = nullptr;
+#endif
+    unsigned* sq_head = nullptr;
+    unsigned* sq_tail = nullptr;
+    unsigned* sq_array = nullptr;
+    unsigned* cq_head = nullptr;
+    unsigned* cq_tail = nullptr;
+    unsigned sq_mask = 0, cq_mask = 0, sq_entries = 0;
+    // prepared, not yet submitted
+    unsigned queued = 0;
+    std::deque<Completion> done;
+};
+
+// input and output through the ring, @p transcode run on the filled buffers in input order:
+// size_t(char* in, size_t n, char* out), npos for a bad input; @p finish writes what is left at the
+// end into the buffer it is given. Buffer seq lives in slot seq % depth; a slot is read into, transcoded,
+// written out and only then reused. Regular files take reads and writes at explicit offsets, several at
+// a time; pipes (and O_APPEND files, whose writes all go to the end) one at a time, at the file position
+template <class Transcode, class Finish>
+int pipeline(const Options& opt, int in, int out, size_t out_block, Transcode transcode, Finish finish) {
+    enum State { idle, reading, filled, transcoded, writing };
+    struct Slot {
+        std::vector<char> in, out;
+        State state = idle;
+        size_t fill = 0, size = 0, written = 0;
+        off_t in_offset = 0, out_offset = 0;
+    };
+    const unsigned depth = opt.depth;
+    std::vector<Slot> slots(depth);
+    for (Slot& s : slots) {
+        s.in.resize(opt.block);
+        s.out.resize(out_block);
+    }
+    struct stat st;
+    const bool seek_in = fstat(in, &st) == 0 && S_ISREG(st.st_mode);
+    const bool seek_out = fstat(out, &st) == 0 && S_ISREG(st.st_mode) && !(fcntl(out, F_GETFL) & O_APPEND);
+    off_t in_pos = seek_in ? lseek(in, 0, SEEK_CUR) : -1;
+    off_t out_pos = seek_out ? lseek(out, 0, SEEK_CUR) : -1;
+
+    Ring ring;
+    ring.open(2 * depth);
+    // tags: 2 * slot for reads, 2 * slot + 1 for writes
+    auto read = [&](unsigned i) {
+        Slot& s = slots[i];
+        return ring.prepare(false, in, s.in.data() + s.fill, s.in.size() - s.fill, seek_in ? s.in_offset + off_t(s.fill) : -1,
+                     2 * i);
+    };
+    auto write = [&](unsigned i) {
+        Slot& s = slots[i];
+        return ring.prepare(true, out, s.out.data() + s.written, s.size - s.written,
+                     seek_out ? s.out_offset + off_t(s.written) : -1, 2 * i + 1);
+    };
+
+    size_t next_read = 0, next_transcode = 0, next_write = 0;
+    unsigned reads = 0, writes = 0;
+    bool eof = false;
+    // on errors, waits for the requests in flight before the buffers go, or tears the ring down if it
+    // cannot report them all
+    auto stop = [&](int status) {
+        uint64_t tag;
+        long result;
+        while (reads + writes && ring.next(tag, result))
+            (tag & 1) ? --writes : --reads;
+        if (reads + writes)
+            ring.close();
+        return status;
+    };
+    // a request the ring has no room for
+    auto refused = [&](const char* what, const char* path) {
+        errno = EAGAIN;
+        return stop(fail(what, path));
+    };
+    for (;;) {
+        while (!eof && (seek_in || reads == 0) && slots[next_read % depth].state == idle) {
+            Slot& s = slots[next_read % depth];
+            s.state = reading;
+            s.fill = 0;
+            s.in_offset = in_pos;
+            in_pos += seek_in ? off_t(opt.block) : 0;
+            if (!read(unsigned(next_read++ % depth)))
+                return refused("cannot read", opt.input);
+            ++reads;
+        }
+        ring.submit();
+        while (next_transcode < next_read && slots[next_transcode % depth].state == filled) {
+            Slot& s = slots[next_transcode++ % depth];
+            s.size = transcode(s.in.data(), s.fill, s.out.data());
+            if (s.size == ct::Base64::npos)
+                return stop(1);
+            s.written = 0;
+            s.state = transcoded;
+        }
+        while (next_write < next_transcode && (seek_out || writes == 0) &&
+               slots[next_write % depth].state == transcoded) {
+            Slot& s = slots[next_write % depth];
+            s.out_offset = out_pos;
+            out_pos += seek_out ? off_t(s.size) : 0;
+            s.state = s.size ? writing : idle;
+            if (s.size) {
+                if (!write(unsigned(next_write % depth)))
+                    return refused("cannot write", opt.output);
+                ++writes;
+            }
+            ++next_write;
+        }
+        ring.submit();
+        if (eof && next_write == next_read && reads == 0 && writes == 0)
+            break;
+
+        uint64_t tag;
+        long result;
+        if (!ring.next(tag, result))
+            return stop(fail("cannot transcode", opt.input));
+        Slot& s = slots[tag / 2];
+        if (result < 0) {
+            (tag & 1) ? --writes : --reads;
+            errno = int(-result);
+            return stop((tag & 1) ? fail("cannot write", opt.output) : fail("cannot read", opt.input));
+        }
+        if (tag & 1) {
+            s.written += size_t(result);
+            if (s.written < s.size) {
+                if (!write(unsigned(tag / 2))) {
+                    --writes;
+                    return refused("cannot write", opt.output);
+                }
+            } else {
+                s.state = idle;
+                --writes;
+            }
+        } else {
+            s.fill += size_t(result);
+            eof = eof || result == 0;
+            // a short read of a regular file is only the end of it once a read returns nothing
+            if (seek_in && result != 0 && s.fill < s.in.size()) {
+                if (!read(unsigned(tag / 2))) {
+                    --reads;
+                    return refused("cannot read", opt.input);
+                }
+            } else {
+                s.state = filled;
+                --reads;
+            }
+        }
+    }
+
+    // the last group, written with blocking calls
+    std::vector<char> tail(out_block);
+    const size_t size = finish(tail.data());
+    if (size == ct::Base64::npos)
+        return 1;
+    for (size_t done = 0; done < size;) {
+        const ssize_t n = seek_out ? pwrite(out, tail.data() + done, size - done, out_pos + off_t(done))
+                                   : ::write(out, tail.data() + done, size - done);
+        if (n < 0 && errno != EINTR)
+            return fail("cannot write", opt.output);
+        done += n < 0 ? 0 : size_t(n);
+    }
+    if (seek_out)
+        lseek(out, out_pos + off_t(size), SEEK_SET);
+    return 0;
+}
+
+template <class Codec>
+int pipe_encode(const Options& opt, int in, int out) {
+    const ct::LineWrap wrap = { opt.cols, opt.crlf };
+    typename Codec::Encoder encoder(wrap);
+    return pipeline(opt, in, out, Codec::encoded_size(opt.block + 2, wrap),
+        [&](char* src, size_t n, char* dst) { return encoder.update(src, n, dst); },
+        [&](char* dst) { return encoder.finish(dst); });
+}
+
+template <class Codec>
+int pipe_decode(const Options& opt, int in, int out) {
+    typename Codec::Decoder decoder;
+    auto invalid = [&] {
+        std::fprintf(stderr, "ct-base64: invalid input '%s' at char %zu (whitespace excluded)\n", opt.input,
+                     decoder.error());
+        return Codec::npos;
+    };
+    return pipeline(opt, in, out, (opt.block + 3) / 4 * 3 + 3,
+        [&](char* src, size_t n, char* dst) {
+            // the whitespace is taken out in place, as decode_relaxed skips it
+            size_t kept = 0;
+            for (size_t i = 0; i < n; ++i) {
+                src[kept] = src[i];
+                kept += ct::impl::is_space(src[i]) ? 0 : 1;
+            }
+            const size_t size = decoder.update(src, kept, dst);
+            return size == Codec::npos ? invalid() : size;
+        },
+        [&](char* dst) {
+            const size_t size = decoder.finish(dst);
+            return size == Codec::npos ? invalid() : size;
+        });
+}
+
+// opens the files of the pipeline, '-' for stdin and stdout
+template <class Codec>
+int pipe_run(const Options& opt) {
+    const bool std_in = std::strcmp(opt.input, "-") == 0, std_out = std::strcmp(opt.output, "-") == 0;
+    const int in = std_in ? STDIN_FILENO : ::open(opt.input, O_RDONLY);
+    if (in < 0)
+        return fail("cannot open", opt.input);
+    if (!std_out && same_file(in, opt.output)) {
+        if (!std_in)
+            close(in);
+        return refuse_same_file(opt.output);
+    }
+    const int out = std_out ? STDOUT_FILENO : ::open(opt.output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) {
+        if (!std_in)
+            close(in);
+        return fail("cannot open", opt.output);
+    }
+    const int status = opt.decode ? pipe_decode<Codec>(opt, in, out) : pipe_encode<Codec>(opt, in, out);
+    if (!std_in)
+        close(in);
+    if (!std_out && close(out) != 0 && status == 0)
+        return fail("cannot write", opt.output);
+    return status;
+}
+
+// the pipeline for pipes, FIFOs, character devices and '-', and when asked for
+bool use_pipeline(const Options& opt) {
+    struct stat st;
+    if (opt.pipeline || std::strcmp(opt.input, "-") == 0 || std::strcmp(opt.output, "-") == 0)
+        return true;
+    if (stat(opt.input, &st) == 0 && !S_ISREG(st.st_mode))
+        return true;
+    return stat(opt.output, &st) == 0 && !S_ISREG(st.st_mode);
+}
+
+template <class Alphabet>
+int run(const Options& opt) {
+    if (use_pipeline(opt))
+        return opt.padding ? pipe_run<ct::BasicBase64<Alphabet>>(opt) : pipe_run<ct::BasicBase64<Alphabet, false>>(opt);
+    Mapping in, out;
+    if (!in.open_input(opt.input))
+        return fail("cannot map", opt.input);
+    if (in.is(opt.output))
+        return refuse_same_file(opt.output);
+    if (opt.padding)
+        return opt.decode ? decode<ct::BasicBase64<Alphabet>>(opt, in, out)
+                          : encode<ct::BasicBase64<Alphabet>>(opt, in, out);
+    return opt.decode ? decode<ct::BasicBase64<Alphabet, false>>(opt, in, out)
+                      : encode<ct::BasicBase64<Alphabet, false>>(opt, in, out);
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    int c;
+    while ((c = getopt(argc, argv, "da:uw:cj:p")) != -1) {
+        switch (c) {
+            case 'd': opt.decode = true; break;
+            case 'a': opt.alphabet = optarg; break;
+            case 'u': opt.padding = false; break;
+            case 'w': opt.cols = std::strtoul(optarg, nullptr, 10); break;
+            case 'c': opt.crlf = true; break;
+            case 'j': opt.parallel.threads = unsigned(std::strtoul(optarg, nullptr, 10)); break;
+            case 'p': opt.pipeline = true; break;
+            default:  return usage(argv[0]);
+        }
+    }
+    if (argc - optind != 2 || opt.cols % 4 != 0)
+        return usage(argv[0]);
+    opt.input = argv[optind];
+    opt.output = argv[optind + 1];
+
+    if (std::strcmp(opt.alphabet, "legacy") == 0)
+        return run<ct::alphabet::Legacy>(opt);
+    if (std::strcmp(opt.alphabet, "standard") == 0)
+        return run<ct::alphabet::Standard>(opt);
+    if (std::strcmp(opt.alphabet, "url") == 0)
+        return run<ct::alphabet::UrlSafe>(opt);
+    return usage(argv[0]);
+}
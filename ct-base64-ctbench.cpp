@@ -0,0 +1,259 @@
+/**
+ * Compile-time lib
+ * @file    ct-base64-ctbench.cpp
+ * @brief   Compile-time cost benchmark of CTSTRING, CT_BASE64_ENCODE and CT_BASE64_DECODE (POSIX)
+ * @author  Douglas Oliveira
+ * @date    2026-10-16
+ *
+ * For every literal length from 16 to 16384 chars (doubling), a translation unit holding one CTSTRING,
+ * CT_BASE64_ENCODE or CT_BASE64_DECODE of a generated literal is written to the work directory and
+ * compiled to an object file; the compiler's wall time (Timer<millisec>), CPU time and peak RSS (wait4)
+ * and the object size are recorded (the best of a few runs), next to a unit that only includes
+ * ct-base64.hpp. The units are compiled as C++14 unless -s picks another standard, which every row
+ * records. The CPU time and peak RSS over that baseline are compared with the ones of the previous
+ * length: a growth of 2 is linear, 4 quadratic. Their least-squares exponent over length, per macro, is
+ * summed up on stderr.
+ *
+ * build: g++ -std=c++14 -O2 ct-base64-ctbench.cpp -o ct-base64-ctbench
+ * usage: ct-base64-ctbench [-c compiler] [-s std] [-I include_dir] [-w work_dir] [-f csv|json] [-m max_length] [-r runs]
+ */
+
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Timer.hpp leaves <functional> and <ctime> to its includer
+#include "Timer.hpp"
+
+extern char** environ;
+
+namespace
+{
+
+struct Options {
+    const char* compiler = std::getenv("CXX") ? std::getenv("CXX") : "c++";
+    // passed as -std=, e.g. c++17 for the constexpr lambda of CTSTRING
+    const char* standard = "c++14";
+    const char* include = ".";
+    const char* work = "/tmp";
+    bool json = false;
+    size_t max_length = 16384;
+    unsigned runs = 3;
+};
+
+// what one translation unit instantiates, %s standing for the literal
+struct Kind {
+    const char* name;
+    const char* code;
+};
+
+const Kind kinds[] = {
+    { "include", "" },
+    { "ctstring", "const char* p = CTSTRING(\"%s\").data;\n" },
+    { "encode", "const char* p = CT_BASE64_ENCODE(\"%s\").data;\n" },
+    { "decode", "const char* p = CT_BASE64_DECODE(\"%s\").data;\n" },
+};
+
+struct Result {
+    const char* kind;
+    size_t length;
+    // exit status of the compiler, 0 on success
+    int status;
+    double wall_ms;
+    // user plus system, steadier than the wall time
+    double cpu_ms;
+    long peak_rss_kb;
+    long object_bytes;
+    // of the cost over the baseline, against the previous length; 0 for the first one and below the
+    // timer noise
+    double cpu_growth;
+    double rss_growth;
+};
+
+int usage(const char* name) {
+    std::fprintf(stderr,
+        "usage: %s [-c compiler] [-s std] [-I include_dir] [-w work_dir] [-f csv|json] [-m max_length] [-r runs]\n"
+        "  -c compiler  default $CXX, or c++\n"
+        "  -s std       language standard, passed as -std=std (default c++14)\n"
+        "  -I dir       where ct-base64.hpp is (default .)\n"
+        "  -w dir       where the generated units and objects go (default /tmp)\n"
+        "  -f format    csv (default) or json, on stdout\n"
+        "  -m length    longest literal (default 16384)\n"
+        "  -r runs      compilations per unit, the best one is kept (default 3)\n",
+        name);
+    return 2;
+}
+
+// @p length chars out of the alphabets of both Base64 and the string literals: a valid encoding for
+// the multiples of 4, and as cheap to lex as any text
+std::string literal(size_t length) {
+    static const char symbols[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    std::string s(length, 'A');
+    uint32_t seed = 2463534242u;
+    for (char& c : s) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        c = symbols[seed % 62];
+    }
+    return s;
+}
+
+bool write_unit(const std::string& path, const Kind& kind, const std::string& text) {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f)
+        return false;
+    std::fprintf(f, "#include \"ct-base64.hpp\"\n");
+    std::fprintf(f, kind.code, text.c_str());
+    return std::fclose(f) == 0;
+}
+
+// runs the compiler on @p source, fills in status, wall time, peak RSS and object size (the lowest
+// wall time and peak RSS seen so far in @p r, if any)
+bool compile(const Options& opt, const std::string& source, const std::string& object, Result& r) {
+    const std::string include = std::string("-I") + opt.include;
+    const std::string standard = std::string("-std=") + opt.standard;
+    const char* argv[] = { opt.compiler, standard.c_str(), "-O2", include.c_str(), "-c", source.c_str(),
+                           "-o", object.c_str(), nullptr };
+    std::remove(object.c_str());
+    Timer<millisec> timer;
+    timer.start();
+    pid_t pid;
+    if (posix_spawnp(&pid, opt.compiler, nullptr, nullptr, const_cast<char**>(argv), environ) != 0)
+        return false;
+    int status = 0;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) != pid)
+        return false;
+    timer.stop();
+    r.status = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    if (r.wall_ms == 0 || timer.elapsed() < r.wall_ms)
+        r.wall_ms = timer.elapsed();
+    const double cpu_ms = (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e3 +
+                          (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e3;
+    if (r.cpu_ms == 0 || cpu_ms < r.cpu_ms)
+        r.cpu_ms = cpu_ms;
+    // kilobytes on Linux
+    if (r.peak_rss_kb == 0 || usage.ru_maxrss < r.peak_rss_kb)
+        r.peak_rss_kb = usage.ru_maxrss;
+    struct stat st;
+    r.object_bytes = r.status == 0 && stat(object.c_str(), &st) == 0 ? long(st.st_size) : 0;
+    return true;
+}
+
+// cost of @p r over the baseline @p base
+double extra(const Result& r, const Result& base, bool rss) {
+    return rss ? double(r.peak_rss_kb - base.peak_rss_kb) : r.cpu_ms - base.cpu_ms;
+}
+
+// @p cost over @p previous, 0 unless both are over @p noise
+double growth(double cost, double previous, double noise) {
+    return cost > noise && previous > noise ? cost / previous : 0.0;
+}
+
+// least-squares slope of log(extra cost) over log(length), for the successful rows of @p kind that
+// cost noticeably more than the baseline (results[0])
+double exponent(const std::vector<Result>& results, const char* kind, bool rss) {
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    size_t n = 0;
+    for (const Result& r : results) {
+        if (std::strcmp(r.kind, kind) != 0 || r.status != 0 || extra(r, results[0], rss) <= (rss ? 1024.0 : 20.0))
+            continue;
+        const double x = std::log(double(r.length)), y = std::log(extra(r, results[0], rss));
+        sx += x; sy += y; sxx += x * x; sxy += x * y;
+        ++n;
+    }
+    return n > 1 ? (n * sxy - sx * sy) / (n * sxx - sx * sx) : 0.0;
+}
+
+void print(const std::vector<Result>& results, const Options& opt) {
+    if (opt.json)
+        std::printf("[\n");
+    else
+        std::printf("kind,std,length,status,wall_ms,cpu_ms,peak_rss_kb,object_bytes,cpu_growth,rss_growth\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        if (opt.json)
+            std::printf("  {\"kind\": \"%s\", \"std\": \"%s\", \"length\": %zu, \"status\": %d, \"wall_ms\": %.1f, "
+                        "\"cpu_ms\": %.1f, \"peak_rss_kb\": %ld, \"object_bytes\": %ld, \"cpu_growth\": %.2f, "
+                        "\"rss_growth\": %.2f}%s\n",
+                        r.kind, opt.standard, r.length, r.status, r.wall_ms, r.cpu_ms, r.peak_rss_kb, r.object_bytes,
+                        r.cpu_growth, r.rss_growth, i + 1 < results.size() ? "," : "");
+        else
+            std::printf("%s,%s,%zu,%d,%.1f,%.1f,%ld,%ld,%.2f,%.2f\n", r.kind, opt.standard, r.length, r.status, r.wall_ms,
+                        r.cpu_ms, r.peak_rss_kb, r.object_bytes, r.cpu_growth, r.rss_growth);
+    }
+    if (opt.json)
+        std::printf("]\n");
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    int c;
+    while ((c = getopt(argc, argv, "c:s:I:w:f:m:r:")) != -1) {
+        switch (c) {
+            case 'c': opt.compiler = optarg; break;
+            case 's': opt.standard = optarg; break;
+            case 'I': opt.include = optarg; break;
+            case 'w': opt.work = optarg; break;
+            case 'f': opt.json = std::strcmp(optarg, "json") == 0; break;
+            case 'm': opt.max_length = std::strtoul(optarg, nullptr, 10); break;
+            case 'r': opt.runs = unsigned(std::strtoul(optarg, nullptr, 10)); break;
+            default:  return usage(argv[0]);
+        }
+    }
+    if (argc != optind || opt.max_length < 16 || opt.runs == 0)
+        return usage(argv[0]);
+
+    const std::string base = std::string(opt.work) + "/ct-base64-ctbench-" + std::to_string(getpid());
+    const std::string source = base + ".cpp", object = base + ".o";
+    std::vector<Result> results;
+    for (const Kind& kind : kinds) {
+        // the baseline includes the header alone
+        const bool baseline = kind.code[0] == '\0';
+        const size_t first = results.size();
+        for (size_t length = baseline ? 0 : 16; length <= opt.max_length; length = baseline ? opt.max_length + 1 : length * 2) {
+            Result r = { kind.name, length, 0, 0.0, 0.0, 0, 0, 0.0, 0.0 };
+            if (!write_unit(source, kind, literal(length))) {
+                std::fprintf(stderr, "ct-base64-ctbench: cannot write '%s': %s\n", source.c_str(), std::strerror(errno));
+                return 1;
+            }
+            for (unsigned run = 0; run < opt.runs && r.status == 0; ++run) {
+                if (!compile(opt, source, object, r)) {
+                    std::fprintf(stderr, "ct-base64-ctbench: cannot run '%s': %s\n", opt.compiler, std::strerror(errno));
+                    return 1;
+                }
+            }
+            const Result* previous = results.size() > first ? &results.back() : nullptr;
+            if (previous && previous->status == 0 && r.status == 0) {
+                const Result& base = results[0];
+                r.cpu_growth = growth(extra(r, base, false), extra(*previous, base, false), 20.0);
+                r.rss_growth = growth(extra(r, base, true), extra(*previous, base, true), 1024.0);
+            }
+            results.push_back(r);
+            std::fprintf(stderr, "%s %zu: %.0f ms, %ld KB\n", r.kind, r.length, r.cpu_ms, r.peak_rss_kb);
+        }
+    }
+    std::remove(source.c_str());
+    std::remove(object.c_str());
+
+    print(results, opt);
+    for (const Kind& kind : kinds) {
+        if (kind.code[0] != '\0')
+            std::fprintf(stderr, "%s: CPU time ~ length^%.2f, peak RSS ~ length^%.2f (over the baseline)\n", kind.name,
+                         exponent(results, kind.name, false), exponent(results, kind.name, true));
+    }
+    return 0;
+}
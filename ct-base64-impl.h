@@ -2,130 +2,392 @@
 
 namespace impl
 {
-    static constexpr const b64char dict[64] = {
-        'A','B','C','D','E','F','G','H','I','J','K','L','M','N','O','P','Q','R','S','T','U','V','W','X','Y','Z',
-        'a','b','c','d','e','f','g','h','i','j','k','l','m','n','o','p','q','r','s','t','u','v','w','x','y','z',
-        '0','1','2','3','4','5','6','7','8','9','@','&'
+    // the decode LUT of the tables of every codec (Base64 and Base32/Base16, base 85), see rt::find_invalid
+    struct SymbolIndex {
+        // dict index of every char, -1 for the chars out of dict
+        int8_t index[256];
+
+        constexpr SymbolIndex() : index() {
+            for (int c = 0; c < 256; ++c)
+                index[c] = -1;
+        }
+    };
+
+    // a whole group, lcm(8, bits) bits: 1 byte in 2 chars (4 bits), 5 in 8 (5 bits), 3 in 4 (6 bits)
+    constexpr size_t group_bytes(unsigned bits) {
+        return bits / (bits % 4 == 0 ? 4 : bits % 2 == 0 ? 2 : 1);
+    }
+
+    constexpr size_t group_chars(unsigned bits) {
+        return 8 / (bits % 4 == 0 ? 4 : bits % 2 == 0 ? 2 : 1);
+    }
+
+    // dict, decode LUT and group layout of an alphabet policy of 16, 32 or 64 symbols (Base16, Base32,
+    // Base64), built at compile time; the aliases are in the decode LUT too
+    struct Tables : SymbolIndex {
+        // bits per symbol: 4, 5 or 6 (0 for an unsupported number of symbols)
+        unsigned bits;
+        size_t group_bytes;
+        size_t group_chars;
+        b64char dict[64];
+        // per low nibble, the bit mask of the high nibbles (0-7) that make a symbol with it
+        uint8_t nibbles[16];
+        // A-Z, a-z, 0-9 and two symbols, in this order (the layout handled by the SSE4.1/AVX2 kernels)
+        bool ranges;
+        // no symbol above 0x7F (the layout handled by the SIMD validation kernels)
+        bool ascii;
+        // 16, 32 or 64 distinct symbols, none of them '=', and aliases of symbols only
+        bool valid;
+
+        constexpr Tables(const b64char* symbols, const b64char* aliases)
+            : bits(0), group_bytes(0), group_chars(0), dict(), nibbles(), ranges(true), ascii(true), valid(true) {
+            size_t n = 0;
+            while (symbols[n] != '\0')
+                ++n;
+            bits = n == 16 ? 4 : n == 32 ? 5 : n == 64 ? 6 : 0;
+            valid = bits != 0;
+            ranges = bits == 6;
+            group_bytes = impl::group_bytes(bits);
+            group_chars = impl::group_chars(bits);
+            for (size_t i = 0; valid && i < n; ++i) {
+                const b64char s = symbols[i];
+                const b64char range = b64char(i < 26 ? 'A' + i : i < 52 ? 'a' + i - 26 : '0' + i - 52);
+                if (index[uint8_t(s)] >= 0 || s == '=')
+                    valid = false;
+                if (i < 62 && s != range)
+                    ranges = false;
+                if (uint8_t(s) >= 0x80)
+                    ascii = false;
+                dict[i] = s;
+                index[uint8_t(s)] = int8_t(i);
+            }
+            for (size_t i = 0; valid && aliases[i] != '\0'; i += 2) {
+                const uint8_t a = uint8_t(aliases[i]), s = uint8_t(aliases[i + 1]);
+                if (s == '\0' || index[a] >= 0 || a == '=' || index[s] < 0)
+                    valid = false;
+                else
+                    index[a] = index[s];
+                if (a >= 0x80)
+                    ascii = false;
+            }
+            for (int c = 0; c < 0x80; ++c) {
+                if (index[c] >= 0)
+                    nibbles[c & 0x0F] = uint8_t(nibbles[c & 0x0F] | 1 << (c >> 4));
+            }
+        }
+    };
+
+    // Alphabet::aliases(), or none
+    template<class Alphabet>
+    constexpr auto aliases_of(int) -> decltype(Alphabet::aliases()) {
+        return Alphabet::aliases();
+    }
+
+    template<class Alphabet>
+    constexpr const b64char* aliases_of(long) {
+        return "";
+    }
+
+    template<class Alphabet>
+    struct tables_of {
+        static constexpr Tables value{Alphabet::symbols(), aliases_of<Alphabet>(0)};
     };
 
-    static constexpr index_type indexOf(b64char c) {
-        return index_type (
-            ('A' <= c && c <= 'Z') ? (00 + c - 'A') :
-            ('a' <= c && c <= 'z') ? (26 + c - 'a') :
-            ('0' <= c && c <= '9') ? (52 + c - '0') :
-            (c == '@') ? 62 : (c == '&') ? 63 : 64
-        );
+    template<class Alphabet>
+    constexpr Tables tables_of<Alphabet>::value;
+
+    // LUT lookup, 255 for the chars out of the alphabet
+    template<class Alphabet>
+    constexpr index_type indexOf(b64char c) {
+        return index_type(tables_of<Alphabet>::value.index[uint8_t(c)]);
+    }
+
+    // a short last group of @p c chars holds the c * bits / 8 bytes that need exactly c chars
+    constexpr bool is_tail(const Tables& t, size_t c) {
+        return c * t.bits / 8 != 0 && (c * t.bits / 8 * 8 + t.bits - 1) / t.bits == c;
+    }
+
+    // the chars of [chars, chars+n) left once the '=' of a padded last group are taken out: at most the
+    // ones after the shortest tail, and never the first char
+    constexpr size_t unpadded_length(const Tables& t, const b64char* chars, size_t n) {
+        const size_t most = t.group_chars - (8 + t.bits - 1) / t.bits;
+        size_t end = n;
+        while (end > 1 && n - end < most && chars[end - 1] == '=')
+            --end;
+        return end;
+    }
+
+    // the checks and codecs below run as constexpr loops over a plain array, which is then lifted into a
+    // ct::string in one step: no template recursion per group and no chain of concatenations.
+    // The input pack and the tables are copied to locals first, GCC reads the elements of static
+    // constexpr arrays (like ct::string::data) in linear time
+    template<size_t n>
+    struct char_array {
+        b64char data[n + 1];
+    };
+
+    // spaces, tabs, CR and LF, skipped by the relaxed decoders
+    constexpr bool is_space(b64char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    template<b64char... chars>
+    constexpr size_t count_non_space() {
+        const b64char in[] = {chars..., '\0'};
+        size_t n = 0;
+        for (size_t i = 0; i < sizeof...(chars); ++i)
+            n += is_space(in[i]) ? 0 : 1;
+        return n;
+    }
+
+    // the chars out of is_space, in order
+    template<b64char... chars>
+    constexpr char_array<sizeof...(chars)> compact_chars() {
+        const b64char in[] = {chars..., '\0'};
+        char_array<sizeof...(chars)> out{};
+        size_t n = 0;
+        for (size_t i = 0; i < sizeof...(chars); ++i) {
+            if (!is_space(in[i]))
+                out.data[n++] = in[i];
+        }
+        return out;
     }
 
     namespace checks {
-        template<char... chars>
-        constexpr auto is_base64_chars_v = std::integral_constant<bool, is_base64_chars_v<chars...> >::value;
-        template<char head, char... tail>
-        constexpr auto is_base64_chars_v<head, tail...> = std::integral_constant<bool, indexOf(head) < 64 && is_base64_chars_v<tail...> >::value;
-        template<char head>
-        constexpr auto is_base64_chars_v<head, '=', '='> = std::integral_constant<bool, indexOf(head) < 64 >::value;
-        template<char head>
-        constexpr auto is_base64_chars_v<head, '='> = std::integral_constant<bool, indexOf(head) < 64 >::value;
-        template<>
-        constexpr auto is_base64_chars_v<> = std::true_type::value;
+        // the chars of the unpadded_length, all in dict ('=' is only accepted as padding)
+        template<class A, bool padding>
+        constexpr bool is_chars(const b64char* chars, size_t n) {
+            const Tables t = tables_of<A>::value;
+            const size_t end = padding ? unpadded_length(t, chars, n) : n;
+            for (size_t i = 0; i < end; ++i) {
+                if (t.index[uint8_t(chars[i])] < 0)
+                    return false;
+            }
+            return true;
+        }
+
+        // with padding the length is a multiple of the group and '=' may only fill the end of the last
+        // group; the symbols of a short last group must make whole bytes
+        template<class A, bool padding>
+        constexpr bool is_encoding(const b64char* chars, size_t n) {
+            const Tables t = tables_of<A>::value;
+            if (padding && n % t.group_chars != 0)
+                return false;
+            const size_t end = padding ? unpadded_length(t, chars, n) : n;
+            return is_chars<A, padding>(chars, n) && (end % t.group_chars == 0 || is_tail(t, end % t.group_chars));
+        }
+
+        template<class A, bool padding, char... chars>
+        constexpr bool is_chars_pack() {
+            const b64char in[] = {chars..., '\0'};
+            return is_chars<A, padding>(in, sizeof...(chars));
+        }
+
+        template<class A, bool padding, char... chars>
+        constexpr auto is_chars_v = std::integral_constant<bool, is_chars_pack<A, padding, chars...>()>::value;
+
+        // Base64 lengths: without padding the last group holds 2 or 3 chars
+        template<bool padding, size_t n>
+        constexpr auto is_valid_length_v = std::integral_constant<bool, padding ? n % 4 == 0 : n % 4 != 1>::value;
+
+        template<class A, bool padding, char... chars>
+        constexpr bool is_encoding_pack() {
+            const b64char in[] = {chars..., '\0'};
+            return is_encoding<A, padding>(in, sizeof...(chars));
+        }
 
+        template<class A, bool padding, char... chars>
+        constexpr auto is_encoding_v = std::integral_constant<bool, is_encoding_pack<A, padding, chars...>()>::value;
+
+        // ct::Base64 (legacy alphabet, padded)
+        template<char... chars>
+        constexpr auto is_base64_chars_v = is_chars_v<alphabet::Legacy, true, chars...>;
         template<size_t n>
-        constexpr auto is_base64_valid_length_v = std::integral_constant<bool, n % 4 == 0>::value;
+        constexpr auto is_base64_valid_length_v = is_valid_length_v<true, n>;
+        template<char... chars>
+        constexpr auto is_base64_encoding_v = is_encoding_v<alphabet::Legacy, true, chars...>;
+
+        // relaxed variants, for wrapped text: spaces, tabs, CR and LF are skipped
+        template<class A, bool padding, char... chars>
+        constexpr bool is_chars_relaxed() {
+            const char_array<sizeof...(chars)> in = compact_chars<chars...>();
+            return is_chars<A, padding>(in.data, count_non_space<chars...>());
+        }
+
+        template<class A, bool padding, char... chars>
+        constexpr auto is_chars_relaxed_v = std::integral_constant<bool, is_chars_relaxed<A, padding, chars...>()>::value;
+
+        template<class A, bool padding, char... chars>
+        constexpr bool is_encoding_relaxed() {
+            const char_array<sizeof...(chars)> in = compact_chars<chars...>();
+            return is_encoding<A, padding>(in.data, count_non_space<chars...>());
+        }
+
+        template<class A, bool padding, char... chars>
+        constexpr auto is_encoding_relaxed_v = std::integral_constant<bool, is_encoding_relaxed<A, padding, chars...>()>::value;
 
         template<char... chars>
-        constexpr auto is_base64_encoding_v = std::integral_constant<bool,
-            is_base64_valid_length_v<sizeof...(chars)> &&
-            is_base64_chars_v<chars...> >::value;
+        constexpr auto is_base64_chars_relaxed_v = is_chars_relaxed_v<alphabet::Legacy, true, chars...>;
+        template<char... chars>
+        constexpr auto is_base64_encoding_relaxed_v = is_encoding_relaxed_v<alphabet::Legacy, true, chars...>;
     }
 
     //////////// Encoder Impl. ////////////
 
-    template<char...chars>
-    struct CTBase64Encoder {
-        static constexpr auto encoded_string = CTBase64Encoder<chars...>::encoded_string;
-    };
+    constexpr size_t encoded_length(unsigned bits, size_t n, bool padding) {
+        return padding ? (n + group_bytes(bits) - 1) / group_bytes(bits) * group_chars(bits)
+                       : n / group_bytes(bits) * group_chars(bits) + (n % group_bytes(bits) * 8 + bits - 1) / bits;
+    }
 
-    template<char c1, char c2, char c3, char...chars>
-    struct CTBase64Encoder<c1, c2, c3, chars...> {
-        typedef ct::string<dict[(c1  & 0xFC) >> 2],
-                            dict[((c1 & 0x03) << 4) | ((c2 & 0xF0) >> 4)],
-                            dict[((c2 & 0x0F) << 2) | ((c3 & 0xC0) >> 6)],
-                            dict[(c3  & 0x3F)]> value_type;
+    // encoded chars plus a line break (of @p eol chars) after every line, the last one included
+    constexpr size_t wrapped_length(size_t chars, size_t cols, size_t eol) {
+        return chars + (cols ? (chars + cols - 1) / cols * eol : 0);
+    }
 
-        static constexpr auto encoded_string = value_type() + CTBase64Encoder<chars...>::encoded_string;
-    };
-    template<char c1, char c2>
-    struct CTBase64Encoder<c1, c2> {
-        typedef ct::string<dict[(c1  & 0xFC) >> 2],
-                            dict[((c1 & 0x03) << 4) | ((c2 & 0xF0) >> 4)],
-                            dict[(c2  & 0x0F) << 2], '='> value_type;
+    // appends @p c at out[j], then a line break if it ends a line of @p cols chars (0: no line breaks)
+    template<size_t n>
+    constexpr void put_char(char_array<n>& out, size_t& j, size_t& column, size_t cols, bool crlf, b64char c) {
+        out.data[j++] = c;
+        if (cols && ++column == cols) {
+            if (crlf)
+                out.data[j++] = '\r';
+            out.data[j++] = '\n';
+            column = 0;
+        }
+    }
 
-        static constexpr auto encoded_string = value_type();
-    };
+    template<class A, bool padding, size_t cols, bool crlf, size_t n>
+    constexpr size_t encoded_chars() {
+        return wrapped_length(encoded_length(tables_of<A>::value.bits, n, padding), cols, crlf ? 2 : 1);
+    }
+
+    // the bytes go through a bit buffer, a symbol out whenever it holds bits of them
+    template<class A, bool padding, size_t cols, bool crlf, char... chars>
+    constexpr char_array<encoded_chars<A, padding, cols, crlf, sizeof...(chars)>()> encode_chars() {
+        const Tables t = tables_of<A>::value;
+        const b64char in[] = {chars..., '\0'};
+        const uint32_t mask = (1u << t.bits) - 1;
+        char_array<encoded_chars<A, padding, cols, crlf, sizeof...(chars)>()> out{};
+        size_t j = 0, column = 0, symbols = 0;
+        uint32_t acc = 0;
+        unsigned held = 0;
+        for (size_t i = 0; i < sizeof...(chars); ++i) {
+            acc = (acc & 0xFF) << 8 | uint8_t(in[i]);
+            held += 8;
+            for (; held >= t.bits; held -= t.bits, ++symbols)
+                put_char(out, j, column, cols, crlf, t.dict[(acc >> (held - t.bits)) & mask]);
+        }
+        if (held) {
+            put_char(out, j, column, cols, crlf, t.dict[(acc << (t.bits - held)) & mask]);
+            ++symbols;
+        }
+        for (; padding && symbols % t.group_chars != 0; ++symbols)
+            put_char(out, j, column, cols, crlf, '=');
+        // the last line, when short
+        if (column) {
+            if (crlf)
+                out.data[j++] = '\r';
+            out.data[j++] = '\n';
+        }
+        return out;
+    }
 
-    template<char c1>
-    struct CTBase64Encoder<c1> {
-        typedef ct::string<dict[(c1 & 0xFC) >> 2],
-                            dict[(c1 & 0x03) << 4], '=','='> value_type;
+    template<class A, bool padding, char... chars>
+    struct CTEncoder {
+        static constexpr unsigned length = unsigned(encoded_chars<A, padding, 0, false, sizeof...(chars)>());
 
-        static constexpr auto encoded_string = value_type();
-    };
+        static constexpr auto encoded_string = ct::toolbox::lift_array<char_array<length>, encode_chars<A, padding, 0, false, chars...> >(
+            std::make_integer_sequence<unsigned, length>());
 
-    template<>
-    struct CTBase64Encoder<> {
-        static constexpr auto encoded_string = ct::string<>();
+        template<size_t cols, bool crlf>
+        static constexpr auto lines() {
+            constexpr unsigned wrapped = unsigned(encoded_chars<A, padding, cols, crlf, sizeof...(chars)>());
+            return ct::toolbox::lift_array<char_array<wrapped>, encode_chars<A, padding, cols, crlf, chars...> >(
+                std::make_integer_sequence<unsigned, wrapped>());
+        }
     };
 
     //////////// Decoder Impl. ////////////
 
-    template<int32_t s>
-    using string_from_int = ct::string<(s >> 16) & 0xFF, (s >> 8) & 0xFF, s & 0xFF>;
-
-    template<b64char... chars>
-    struct b64_decoder_impl {
-        static constexpr auto decoded_string = b64_decoder_impl<chars...>::decoded_string;
-    };
+    // whole groups: a short last group still yields all its bytes, its spare bits then zero bytes
+    // (the output of BasicBase64::decode)
+    constexpr size_t decoded_length(const Tables& t, size_t n) {
+        return (n + t.group_chars - 1) / t.group_chars * t.group_bytes;
+    }
 
-    template<b64char c1, b64char c2, b64char c3, b64char c4, b64char... chars>
-    struct b64_decoder_impl<c1, c2, c3, c4, chars...> {
-        typedef string_from_int<indexOf(c1) << 18 | indexOf(c2) << 12 |
-                                indexOf(c3) <<  6 | indexOf(c4)> value_type;
+    // exact payload size: neither the '=' nor the spare bits of a short last group yield a byte
+    template<class A, b64char... chars>
+    constexpr size_t decoded_size() {
+        const b64char in[] = {chars..., '\0'};
+        return unpadded_length(tables_of<A>::value, in, sizeof...(chars)) * tables_of<A>::value.bits / 8;
+    }
 
-        static constexpr auto decoded_string = value_type() + b64_decoder_impl<chars...>::decoded_string;
-    };
+    // the symbols go through a bit buffer, a byte out whenever it holds 8 bits of them; the first @p m
+    // bytes, the ones past the payload from the spare bits, then zero
+    template<class A, size_t m>
+    constexpr char_array<m> decode_array(const b64char* in, size_t n) {
+        const Tables t = tables_of<A>::value;
+        const size_t end = unpadded_length(t, in, n);
+        char_array<m> out{};
+        size_t j = 0;
+        uint32_t acc = 0;
+        unsigned held = 0;
+        for (size_t i = 0; i < end && j < m; ++i) {
+            acc = (acc & 0xFF) << t.bits | uint32_t(t.index[uint8_t(in[i])]);
+            held += t.bits;
+            if (held >= 8) {
+                held -= 8;
+                out.data[j++] = b64char((acc >> held) & 0xFF);
+            }
+        }
+        for (; j < m; acc = 0, held = 0)
+            out.data[j++] = b64char((acc << (8 - held)) & 0xFF);
+        return out;
+    }
 
-    template<b64char c1, b64char c2, b64char c3>
-    struct b64_decoder_impl<c1, c2, c3, '='> {
-        typedef string_from_int<indexOf(c1) << 18 | indexOf(c2) << 12 | indexOf(c3) << 6> value_type;
+    template<class A, bool whole, b64char... chars>
+    constexpr size_t decoded_chars() {
+        return whole ? decoded_length(tables_of<A>::value, sizeof...(chars)) : decoded_size<A, chars...>();
+    }
 
-        static constexpr auto decoded_string = value_type();
-    };
+    template<class A, bool whole, b64char... chars>
+    constexpr char_array<decoded_chars<A, whole, chars...>()> decode_chars() {
+        const b64char in[] = {chars..., '\0'};
+        return decode_array<A, decoded_chars<A, whole, chars...>()>(in, sizeof...(chars));
+    }
 
-    template<b64char c1, b64char c2>
-    struct b64_decoder_impl<c1, c2, '=', '='> {
-        typedef string_from_int<indexOf(c1) << 18 | indexOf(c2) << 12> value_type;
+    template<class A, b64char... chars>
+    constexpr char_array<decoded_length(tables_of<A>::value, count_non_space<chars...>())> decode_chars_relaxed() {
+        const char_array<sizeof...(chars)> in = compact_chars<chars...>();
+        return decode_array<A, decoded_length(tables_of<A>::value, count_non_space<chars...>())>(
+            in.data, count_non_space<chars...>());
+    }
 
-        static constexpr auto decoded_string = value_type();
-    };
+    // the decoded chars lifted into a ct::bytes, as in ct::toolbox::lift_array
+    template<class A, b64char... chars, size_t... I>
+    constexpr auto decode_bytes(std::index_sequence<I...>) {
+        constexpr char_array<decoded_size<A, chars...>()> a = decode_chars<A, false, chars...>();
+        static_cast<void>(a);
+        return ct::bytes<uint8_t(a.data[I])...>();
+    }
 
-    template<>
-    struct b64_decoder_impl<> {
+    template<bool isvalid, class A, bool whole, b64char... chars>
+    struct decode_if {
+        static_assert(isvalid, "Input string is not a valid encoding");
         static constexpr auto decoded_string = ct::string<>();
     };
 
-    template<bool isvalid, b64char... chars>
-    struct b64_decode_if {
-        static_assert(isvalid, "Input string is not a valid base 64 encoding");
-        static constexpr auto decoded_string = ct::string<>();
-    };
+    template<class A, bool whole, b64char... chars>
+    struct decode_if<true, A, whole, chars...> {
+        static constexpr unsigned length = unsigned(decoded_chars<A, whole, chars...>());
 
-    template<b64char... chars>
-    struct b64_decode_if<true, chars...> {
-        static constexpr auto decoded_string = b64_decoder_impl<chars...>::decoded_string;
+        static constexpr auto decoded_string = ct::toolbox::lift_array<char_array<length>, decode_chars<A, whole, chars...> >(
+            std::make_integer_sequence<unsigned, length>());
     };
 
-    template<b64char... chars>
-    struct CTBase64Decoder : b64_decode_if<checks::is_base64_encoding_v<chars...>, chars...> { };
+    // @p whole: see decoded_length, otherwise the exact payload
+    template<class A, bool padding, bool whole, b64char... chars>
+    struct CTDecoder : decode_if<checks::is_encoding_v<A, padding, chars...>, A, whole, chars...> { };
 }
 
 #endif // CT_BASE_64_HPP
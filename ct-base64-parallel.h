@@ -0,0 +1,198 @@
+#ifdef CT_BASE_64_HPP
+
+namespace impl
+{
+namespace rt
+{
+    //////////// Worker Pool ////////////
+
+    // process-wide pool, grown on demand up to the largest thread count asked for so far;
+    // the calling thread takes part in every run, so a run on n threads wakes n - 1 workers
+    class Pool {
+    public:
+        static Pool& instance() {
+            static Pool pool;
+            return pool;
+        }
+
+        // calls job(0) .. job(parts - 1) on at most @p threads threads, returns once all are done
+        void run(unsigned threads, unsigned parts, const std::function<void(unsigned)>& job) {
+            std::lock_guard<std::mutex> serial(running);
+            std::unique_lock<std::mutex> lock(mutex);
+            while (workers.size() + 1 < threads)
+                workers.emplace_back(&Pool::work, this, unsigned(workers.size()));
+            current = &job;
+            nparts = parts;
+            enlisted = threads - 1;
+            next = 0;
+            ++generation;
+            lock.unlock();
+            wake.notify_all();
+
+            help(job, parts);
+
+            // the parts are all taken; wait for the workers still busy with theirs
+            lock.lock();
+            done.wait(lock, [this] { return active == 0; });
+            current = nullptr;
+        }
+
+        ~Pool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop = true;
+            }
+            wake.notify_all();
+            for (std::thread& worker : workers)
+                worker.join();
+        }
+
+    private:
+        Pool() = default;
+
+        void help(const std::function<void(unsigned)>& job, unsigned parts) {
+            for (unsigned part = next++; part < parts; part = next++)
+                job(part);
+        }
+
+        void work(unsigned id) {
+            unsigned seen = 0;
+            std::unique_lock<std::mutex> lock(mutex);
+            for (;;) {
+                wake.wait(lock, [&] { return stop || (current && generation != seen); });
+                if (stop)
+                    return;
+                seen = generation;
+                if (id >= enlisted)
+                    continue;
+                const std::function<void(unsigned)>& job = *current;
+                const unsigned parts = nparts;
+                ++active;
+                lock.unlock();
+                help(job, parts);
+                lock.lock();
+                if (--active == 0)
+                    done.notify_one();
+            }
+        }
+
+        std::mutex running;
+        std::mutex mutex;
+        std::condition_variable wake, done;
+        std::vector<std::thread> workers;
+        const std::function<void(unsigned)>* current = nullptr;
+        unsigned nparts = 0, enlisted = 0, active = 0, generation = 0;
+        std::atomic<unsigned> next{0};
+        bool stop = false;
+    };
+
+    //////////// Parallel Drivers ////////////
+
+    // smallest piece handed to a thread, in groups
+    static constexpr size_t parallel_grain = size_t(1) << 16;
+
+    // number of pieces (of parallel_grain groups at least) for @p size bytes or chars, 1 below the threshold
+    inline unsigned split(const Parallel& parallel, size_t size, size_t groups) {
+        const unsigned threads = parallel.threads ? parallel.threads : std::thread::hardware_concurrency();
+        if (size < parallel.threshold || threads < 2)
+            return 1;
+        const size_t most = groups / parallel_grain;
+        return most < threads ? unsigned(most ? most : 1) : threads;
+    }
+
+    // the pieces get the same number of whole 3-byte groups, only the last one may end with a short group
+    inline size_t encode(const Kernels& k, const Tables& t, bool padding, const uint8_t* in, size_t n, char* out,
+                         const Parallel& parallel) {
+        const size_t groups = n / 3;
+        const unsigned pieces = split(parallel, n, groups);
+        if (pieces == 1)
+            return encode(k, t, padding, in, n, out);
+
+        const size_t span = (groups + pieces - 1) / pieces;
+        const unsigned parts = unsigned((groups + span - 1) / span);
+        Pool::instance().run(parts, parts, [&](unsigned part) {
+            const size_t first = span * part;
+            const size_t count = part + 1 == parts ? n - first * 3 : span * 3;
+            encode(k, t, padding, in + first * 3, count, out + first * 4);
+        });
+        return encoded_length(6, n, padding);
+    }
+
+    // the pieces get the same number of whole 4-char groups; all but the last are decoded as unpadded,
+    // which turns any '=' they hold into a bad char. The first bad char over all pieces is reported
+    inline size_t decode(const Kernels& k, const Tables& t, bool padding, const char* in, size_t n, uint8_t* out,
+                         size_t* error, const Parallel& parallel) {
+        const size_t groups = n / 4;
+        const unsigned pieces = split(parallel, n, groups);
+        if (pieces == 1)
+            return decode(k, t, padding, in, n, out, error);
+
+        const size_t span = (groups + pieces - 1) / pieces;
+        const unsigned parts = unsigned((groups + span - 1) / span);
+        std::vector<size_t> sizes(parts), errors(parts, npos);
+        Pool::instance().run(parts, parts, [&](unsigned part) {
+            const size_t first = span * part;
+            const bool last = part + 1 == parts;
+            const size_t count = last ? n - first * 4 : span * 4;
+            sizes[part] = decode(k, t, last && padding, in + first * 4, count, out + first * 3, &errors[part]);
+        });
+
+        for (unsigned part = 0; part < parts; ++part) {
+            if (sizes[part] == npos)
+                return decode_error(error, span * part * 4 + errors[part]);
+        }
+        return (parts - 1) * span * 3 + sizes[parts - 1];
+    }
+
+    // the pieces get the same number of input chars, each cut moved on to the next whole group of
+    // non-space chars (counted in parallel first); as in decode(), all but the last are unpadded
+    inline size_t decode_relaxed(const Kernels& k, const Tables& t, bool padding, const char* in, size_t n,
+                                 uint8_t* out, size_t* error, const Parallel& parallel) {
+        const unsigned pieces = split(parallel, n, n / 4);
+        if (pieces == 1)
+            return decode_relaxed(k, t, padding, in, n, out, error);
+
+        const size_t span = (n + pieces - 1) / pieces;
+        // non-space chars before span * part
+        std::vector<size_t> counted(pieces, 0);
+        Pool::instance().run(pieces, pieces - 1, [&](unsigned part) {
+            size_t c = 0;
+            for (size_t i = span * part; i < span * (part + 1) && i < n; ++i)
+                c += is_space(in[i]) ? 0 : 1;
+            counted[part + 1] = c;
+        });
+        // offsets of the cuts, and the groups before them
+        std::vector<size_t> cuts(1, 0), groups(1, 0);
+        size_t at = 0, c = 0;
+        for (unsigned part = 1; part < pieces; ++part) {
+            counted[part] += counted[part - 1];
+            if (at < span * part) {
+                at = span * part;
+                c = counted[part];
+            }
+            while (c % 4 && at < n)
+                c += is_space(in[at++]) ? 0 : 1;
+            if (at == n)
+                break;
+            cuts.push_back(at);
+            groups.push_back(c / 4);
+        }
+        cuts.push_back(n);
+
+        const unsigned parts = unsigned(cuts.size() - 1);
+        std::vector<size_t> sizes(parts), errors(parts, npos);
+        Pool::instance().run(parts, parts, [&](unsigned part) {
+            sizes[part] = decode_relaxed(k, t, part + 1 == parts && padding, in + cuts[part], cuts[part + 1] - cuts[part],
+                                         out + groups[part] * 3, &errors[part]);
+        });
+
+        for (unsigned part = 0; part < parts; ++part) {
+            if (sizes[part] == npos)
+                return decode_error(error, cuts[part] + errors[part]);
+        }
+        return groups[parts - 1] * 3 + sizes[parts - 1];
+    }
+}
+}
+
+#endif // CT_BASE_64_HPP
@@ -0,0 +1,1253 @@
+#ifdef CT_BASE_64_HPP
+
+namespace impl
+{
+namespace rt
+{
+    static constexpr size_t npos = size_t(-1);
+
+    //////////// Scalar Encoder ////////////
+
+    // a whole group of the alphabets of @p bits bits, as in Tables
+    template<unsigned bits>
+    struct group {
+        static constexpr size_t bytes = impl::group_bytes(bits);
+        static constexpr size_t chars = impl::group_chars(bits);
+    };
+
+    // same bit layout as CTEncoder, one whole group per iteration, read big-endian and cut into symbols
+    // from the top; encodes the whole groups of [in, in+n) and returns the number of chars written
+    template<unsigned bits>
+    inline size_t encode_scalar(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        typedef group<bits> g;
+        const b64char* dict = t.dict;
+        char* dst = out;
+        for (; n >= g::bytes; n -= g::bytes, in += g::bytes, dst += g::chars) {
+            uint64_t s = 0;
+            for (size_t j = 0; j < g::bytes; ++j)
+                s = s << 8 | in[j];
+            for (size_t j = 0; j < g::chars; ++j)
+                dst[j] = dict[(s >> (bits * (g::chars - 1 - j))) & ((1u << bits) - 1)];
+        }
+        return size_t(dst - out);
+    }
+
+    // Base64, unrolled by hand: GCC leaves the loops above rolled at -O2, at half the speed
+    template<>
+    inline size_t encode_scalar<6>(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const b64char* dict = t.dict;
+        char* dst = out;
+        for (; n >= 3; n -= 3, in += 3) {
+            *dst++ = dict[(in[0] & 0xFC) >> 2];
+            *dst++ = dict[((in[0] & 0x03) << 4) | ((in[1] & 0xF0) >> 4)];
+            *dst++ = dict[((in[1] & 0x0F) << 2) | ((in[2] & 0xC0) >> 6)];
+            *dst++ = dict[(in[2] & 0x3F)];
+        }
+        return size_t(dst - out);
+    }
+
+    // short last group, through a bit buffer as in encode_chars
+    inline size_t encode_tail(const uint8_t* in, size_t n, char* out, const Tables& t, bool padding) {
+        if (n == 0)
+            return 0;
+        uint64_t s = 0;
+        for (size_t j = 0; j < n; ++j)
+            s = s << 8 | in[j];
+        const size_t chars = (n * 8 + t.bits - 1) / t.bits;
+        s <<= chars * t.bits - n * 8;
+        for (size_t j = 0; j < chars; ++j)
+            out[j] = t.dict[(s >> (t.bits * (chars - 1 - j))) & ((1u << t.bits) - 1)];
+        const size_t written = padding ? t.group_chars : chars;
+        for (size_t j = chars; j < written; ++j)
+            out[j] = '=';
+        return written;
+    }
+
+    //////////// Scalar Decoder ////////////
+
+    // offset of the first char of [in, in+n) that is not in dict, or n; for the tables of every codec
+    inline size_t find_invalid(const char* in, size_t n, const SymbolIndex& t) {
+        size_t i = 0;
+        while (i < n && t.index[uint8_t(in[i])] >= 0) ++i;
+        return i;
+    }
+
+    // decodes whole groups (no padding) and stops before the first group holding a char that is not
+    // in dict; returns the number of chars consumed
+    template<unsigned bits>
+    inline size_t decode_scalar(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        typedef group<bits> g;
+        const int8_t* index = t.index;
+        size_t i = 0;
+        for (; i + g::chars <= n; i += g::chars, out += g::bytes) {
+            uint64_t s = 0;
+            int32_t bad = 0;
+            for (size_t j = 0; j < g::chars; ++j) {
+                const int32_t v = index[uint8_t(in[i + j])];
+                bad |= v;
+                s = s << bits | uint8_t(v);
+            }
+            if (bad < 0)
+                break;
+            for (size_t j = 0; j < g::bytes; ++j)
+                out[j] = uint8_t(s >> (8 * (g::bytes - 1 - j)));
+        }
+        return i;
+    }
+
+    // see encode_scalar<6>
+    template<>
+    inline size_t decode_scalar<6>(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const int8_t* index = t.index;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4, out += 3) {
+            const int32_t a = index[uint8_t(in[i])], b = index[uint8_t(in[i+1])],
+                          c = index[uint8_t(in[i+2])], d = index[uint8_t(in[i+3])];
+            if ((a | b | c | d) < 0)
+                break;
+            const uint32_t s = uint32_t(a) << 18 | uint32_t(b) << 12 | uint32_t(c) << 6 | uint32_t(d);
+            out[0] = uint8_t(s >> 16);
+            out[1] = uint8_t(s >> 8);
+            out[2] = uint8_t(s);
+        }
+        return i;
+    }
+
+    // find_invalid with one test per 8 chars, for the inputs that are checked without being decoded
+    inline size_t validate_scalar(const char* in, size_t n, const Tables& t) {
+        const int8_t* index = t.index;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            int32_t m = 0;
+            for (size_t k = 0; k < 8; ++k)
+                m |= index[uint8_t(in[i + k])];
+            if (m < 0)
+                break;
+        }
+        return i + find_invalid(in + i, n - i, t);
+    }
+
+    //////////// Pair Table Codec ////////////
+
+    // per alphabet, two symbols per lookup: the 2 chars of every 12-bit value, and the 12-bit value of
+    // every pair of chars (keyed first char in the low byte, 0xFFFF when either one is out of dict)
+    struct PairTables {
+        b64char encode[4096][2];
+        uint16_t decode[65536];
+
+        constexpr PairTables(const Tables& t) : encode(), decode() {
+            for (int v = 0; v < 4096; ++v) {
+                encode[v][0] = t.dict[v >> 6];
+                encode[v][1] = t.dict[v & 0x3F];
+            }
+            for (int k = 0; k < 65536; ++k) {
+                const int a = t.index[k & 0xFF], b = t.index[k >> 8];
+                decode[k] = (a | b) < 0 ? uint16_t(0xFFFF) : uint16_t(a << 6 | b);
+            }
+        }
+    };
+
+    // built at compile time, only for the alphabets whose runtime codec is used (136 KB each)
+    template<class Alphabet>
+    struct pair_tables_of {
+        static constexpr PairTables value{tables_of<Alphabet>::value};
+    };
+
+    template<class Alphabet>
+    constexpr PairTables pair_tables_of<Alphabet>::value;
+
+    // encode_scalar with 2 chars per lookup
+    template<class A>
+    inline size_t encode_pairs(const uint8_t* in, size_t n, char* out, const Tables&) {
+        const PairTables& p = pair_tables_of<A>::value;
+        char* dst = out;
+        for (; n >= 3; n -= 3, in += 3, dst += 4) {
+            const uint32_t s = uint32_t(in[0]) << 16 | uint32_t(in[1]) << 8 | in[2];
+            std::memcpy(dst, p.encode[s >> 12], 2);
+            std::memcpy(dst + 2, p.encode[s & 0xFFF], 2);
+        }
+        return size_t(dst - out);
+    }
+
+    // decode_scalar with 2 chars per lookup, the flags of both pairs tested at once
+    template<class A>
+    inline size_t decode_pairs(const char* in, size_t n, uint8_t* out, const Tables&) {
+        const uint16_t* pairs = pair_tables_of<A>::value.decode;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4, out += 3) {
+            const uint32_t a = pairs[uint8_t(in[i]) | uint8_t(in[i+1]) << 8];
+            const uint32_t b = pairs[uint8_t(in[i+2]) | uint8_t(in[i+3]) << 8];
+            if ((a | b) > 0xFFF)
+                break;
+            const uint32_t s = a << 12 | b;
+            out[0] = uint8_t(s >> 16);
+            out[1] = uint8_t(s >> 8);
+            out[2] = uint8_t(s);
+        }
+        return i;
+    }
+
+    //////////// Whitespace Compaction ////////////
+
+    // copies the chars of [in, in+n) out of is_space; returns the number of chars kept
+    // (the SIMD versions may write up to 32 bytes past them)
+    inline size_t compact_scalar(const char* in, size_t n, char* out) {
+        char* dst = out;
+        for (size_t i = 0; i < n; ++i) {
+            *dst = in[i];
+            dst += is_space(in[i]) ? 0 : 1;
+        }
+        return size_t(dst - out);
+    }
+
+    // per 8-bit mask of kept bytes: the shuffle that moves them to the front (zeros behind) and their count
+    struct CompactTable {
+        uint8_t shuffle[256][8];
+        uint8_t count[256];
+
+        constexpr CompactTable() : shuffle(), count() {
+            for (int m = 0; m < 256; ++m) {
+                int k = 0;
+                for (int b = 0; b < 8; ++b) {
+                    if (m >> b & 1)
+                        shuffle[m][k++] = uint8_t(b);
+                }
+                count[m] = uint8_t(k);
+                for (; k < 8; ++k)
+                    shuffle[m][k] = 0x80;
+            }
+        }
+    };
+
+    template<class = void>
+    struct compact_table {
+        static constexpr CompactTable value{};
+    };
+
+    template<class T>
+    constexpr CompactTable compact_table<T>::value;
+
+    //////////// Transcoding ////////////
+
+    // per pair of alphabets, the symbol in the target one of every char of the source one (the one of
+    // the same index), 0 for the chars out of its dict
+    struct TranscodeTables {
+        b64char map[256];
+        // of the source alphabet, see Tables
+        uint8_t nibbles[16];
+        // the last two symbols of both, the only ones that differ between two ranges alphabets
+        b64char from62, from63, to62, to63;
+        // both of them ranges and ASCII alphabets (the layout handled by the SSE4.1/AVX2 kernels)
+        bool ranges;
+
+        constexpr TranscodeTables(const Tables& from, const Tables& to)
+            : map(), nibbles(), from62(from.dict[62]), from63(from.dict[63]), to62(to.dict[62]), to63(to.dict[63]),
+              ranges(from.ranges && to.ranges && from.ascii && to.ascii) {
+            for (int c = 0; c < 256; ++c)
+                map[c] = from.index[c] < 0 ? '\0' : to.dict[from.index[c]];
+            for (int i = 0; i < 16; ++i)
+                nibbles[i] = from.nibbles[i];
+        }
+    };
+
+    template<class From, class To>
+    struct transcode_tables_of {
+        static constexpr TranscodeTables value{tables_of<From>::value, tables_of<To>::value};
+    };
+
+    template<class From, class To>
+    constexpr TranscodeTables transcode_tables_of<From, To>::value;
+
+    // rewrites the chars of [in, in+n) into the target alphabet and stops before the first one out of
+    // the source dict; returns the number of chars written (@p out may be @p in)
+    inline size_t transcode_scalar(const char* in, size_t n, char* out, const TranscodeTables& m) {
+        size_t i = 0;
+        for (; i < n; ++i) {
+            const b64char s = m.map[uint8_t(in[i])];
+            if (s == '\0')
+                break;
+            out[i] = s;
+        }
+        return i;
+    }
+
+#ifdef CT_BASE64_X86
+    //////////// SSE4.1 Encoder ////////////
+
+    // maps 16 6-bit indices to dict characters: A-Z, a-z and 0-9 are contiguous ranges,
+    // the last two entries of dict get their own offsets
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i lookup_sse41(__m128i idx, const Tables& t) {
+        const __m128i shift_lut = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, char(t.dict[62] - 62), char(t.dict[63] - 63), 'A', 0, 0);
+        // 0..25 -> 13, 26..51 -> 0, 52..63 -> 1..12
+        __m128i sel = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+        sel = _mm_or_si128(sel, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+        return _mm_add_epi8(idx, _mm_shuffle_epi8(shift_lut, sel));
+    }
+
+    // splits the 3-byte groups held in each 32-bit lane into four 6-bit indices
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i unpack_sse41(__m128i v) {
+        const __m128i t0 = _mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(v, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        return _mm_or_si128(t1, t3);
+    }
+
+    // 12 input bytes -> 16 output chars per iteration (reads 16 bytes)
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t encode_sse41(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m128i shuf = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+        size_t i = 0;
+        char* dst = out;
+        for (; i + 16 <= n; i += 12, dst += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            v = unpack_sse41(_mm_shuffle_epi8(v, shuf));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), lookup_sse41(v, t));
+        }
+        return size_t(dst - out) + encode_scalar<6>(in + i, n - i, dst, t);
+    }
+
+    //////////// AVX2 Encoder ////////////
+
+    CT_BASE64_TARGET("avx2")
+    inline __m256i lookup_avx2(__m256i idx, const Tables& t) {
+        const __m256i shift_lut = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, char(t.dict[62] - 62), char(t.dict[63] - 63), 'A', 0, 0));
+        __m256i sel = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+        sel = _mm256_or_si256(sel, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+        return _mm256_add_epi8(idx, _mm256_shuffle_epi8(shift_lut, sel));
+    }
+
+    CT_BASE64_TARGET("avx2")
+    inline __m256i unpack_avx2(__m256i v) {
+        const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        return _mm256_or_si256(t1, t3);
+    }
+
+    // 24 input bytes -> 32 output chars per iteration, 12 bytes per 128-bit lane (reads 28 bytes)
+    CT_BASE64_TARGET("avx2")
+    inline size_t encode_avx2(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m256i shuf = _mm256_broadcastsi128_si256(
+            _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+        size_t i = 0;
+        char* dst = out;
+        for (; i + 28 <= n; i += 24, dst += 32) {
+            __m256i v = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12)), 1);
+            v = unpack_avx2(_mm256_shuffle_epi8(v, shuf));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), lookup_avx2(v, t));
+        }
+        return size_t(dst - out) + encode_sse41(in + i, n - i, dst, t);
+    }
+
+    //////////// SSE4.1 Decoder ////////////
+
+    // mask of the chars in [lo, lo+len) (unsigned compare)
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i in_range_sse41(__m128i c, char lo, char len) {
+        const __m128i d = _mm_sub_epi8(c, _mm_set1_epi8(lo));
+        return _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(char(len - 1))), d);
+    }
+
+    // translates 16 chars to their dict indices, the chars out of dict are flagged in @p valid
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i indices_sse41(__m128i c, __m128i& valid, const Tables& t) {
+        const __m128i upper = in_range_sse41(c, 'A', 26);
+        const __m128i lower = in_range_sse41(c, 'a', 26);
+        const __m128i digit = in_range_sse41(c, '0', 10);
+        const __m128i c62 = _mm_cmpeq_epi8(c, _mm_set1_epi8(t.dict[62]));
+        const __m128i c63 = _mm_cmpeq_epi8(c, _mm_set1_epi8(t.dict[63]));
+        valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), digit), _mm_or_si128(c62, c63));
+
+        __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(char(0 - 'A')));
+        shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(char(26 - 'a'))));
+        shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(char(52 - '0'))));
+        shift = _mm_or_si128(shift, _mm_and_si128(c62, _mm_set1_epi8(char(62 - t.dict[62]))));
+        shift = _mm_or_si128(shift, _mm_and_si128(c63, _mm_set1_epi8(char(63 - t.dict[63]))));
+        return _mm_add_epi8(c, shift);
+    }
+
+    // joins four 6-bit indices per 32-bit lane into 3 bytes, placed in the low 12 bytes
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i pack_sse41(__m128i idx) {
+        const __m128i merged = _mm_maddubs_epi16(idx, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        return _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    }
+
+    // 16 chars -> 12 bytes per iteration (writes 16 bytes), validation is fused in the same pass
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t decode_sse41(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        size_t i = 0;
+        // keeps the 4-byte overrun of the last store inside the output of the remaining groups
+        for (; i + 24 <= n; i += 16, out += 12) {
+            __m128i valid;
+            const __m128i idx = indices_sse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), valid, t);
+            if (_mm_movemask_epi8(valid) != 0xFFFF)
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), pack_sse41(idx));
+        }
+        return i + decode_scalar<6>(in + i, n - i, out, t);
+    }
+
+    //////////// SSE4.1 Validation ////////////
+
+    // flags the chars of @p c out of dict, any ASCII alphabet: the low nibble of a char picks the
+    // mask of the high nibbles that make a symbol with it (Tables::nibbles), the high one its bit
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i invalid_sse41(__m128i c, __m128i nibbles) {
+        const __m128i bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, char(0x80), 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(c, 4), _mm_set1_epi8(0x0F));
+        const __m128i lo = _mm_and_si128(c, _mm_set1_epi8(0x0F));
+        const __m128i hit = _mm_and_si128(_mm_shuffle_epi8(nibbles, lo), _mm_shuffle_epi8(bits, hi));
+        return _mm_cmpeq_epi8(hit, _mm_setzero_si128());
+    }
+
+    // validate_scalar over 64 chars per test, then 16 to find the bad one
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t validate_sse41(const char* in, size_t n, const Tables& t) {
+        const __m128i nibbles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.nibbles));
+        const __m128i* v = reinterpret_cast<const __m128i*>(in);
+        size_t i = 0;
+        for (; i + 64 <= n; i += 64, v += 4) {
+            const __m128i bad = _mm_or_si128(
+                _mm_or_si128(invalid_sse41(_mm_loadu_si128(v), nibbles), invalid_sse41(_mm_loadu_si128(v + 1), nibbles)),
+                _mm_or_si128(invalid_sse41(_mm_loadu_si128(v + 2), nibbles), invalid_sse41(_mm_loadu_si128(v + 3), nibbles)));
+            if (!_mm_testz_si128(bad, bad))
+                break;
+        }
+        for (; i + 16 <= n; i += 16) {
+            const unsigned bad = unsigned(_mm_movemask_epi8(
+                invalid_sse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), nibbles)));
+            if (bad)
+                return i + unsigned(__builtin_ctz(bad));
+        }
+        return i + validate_scalar(in + i, n - i, t);
+    }
+
+    //////////// SSE4.1 Whitespace Compaction ////////////
+
+    CT_BASE64_TARGET("sse4.1")
+    inline unsigned spaces_sse41(__m128i c) {
+        const __m128i sp = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\t')));
+        const __m128i nl = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(c, _mm_set1_epi8('\n')));
+        return unsigned(_mm_movemask_epi8(_mm_or_si128(sp, nl)));
+    }
+
+    // compresses the 16 chars of @p c flagged in @p keep, one 8-byte half per table entry (writes 16 bytes)
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t compress_sse41(__m128i c, unsigned keep, char* out) {
+        const CompactTable& lut = compact_table<>::value;
+        const unsigned lo = keep & 0xFF, hi = keep >> 8;
+        const __m128i shuf = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(lut.shuffle[lo])),
+            _mm_add_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(lut.shuffle[hi])), _mm_set1_epi8(8)));
+        const __m128i packed = _mm_shuffle_epi8(c, shuf);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), packed);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + lut.count[lo]), _mm_unpackhi_epi64(packed, packed));
+        return size_t(lut.count[lo]) + lut.count[hi];
+    }
+
+    // 16 chars per iteration, the blocks without whitespace are copied as they are
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t compact_sse41(const char* in, size_t n, char* out) {
+        char* dst = out;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const unsigned keep = ~spaces_sse41(c) & 0xFFFF;
+            if (keep == 0xFFFF) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), c);
+                dst += 16;
+            } else {
+                dst += compress_sse41(c, keep, dst);
+            }
+        }
+        return size_t(dst - out) + compact_scalar(in + i, n - i, dst);
+    }
+
+    //////////// AVX2 Decoder ////////////
+
+    CT_BASE64_TARGET("avx2")
+    inline __m256i in_range_avx2(__m256i c, char lo, char len) {
+        const __m256i d = _mm256_sub_epi8(c, _mm256_set1_epi8(lo));
+        return _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(char(len - 1))), d);
+    }
+
+    CT_BASE64_TARGET("avx2")
+    inline __m256i indices_avx2(__m256i c, __m256i& valid, const Tables& t) {
+        const __m256i upper = in_range_avx2(c, 'A', 26);
+        const __m256i lower = in_range_avx2(c, 'a', 26);
+        const __m256i digit = in_range_avx2(c, '0', 10);
+        const __m256i c62 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(t.dict[62]));
+        const __m256i c63 = _mm256_cmpeq_epi8(c, _mm256_set1_epi8(t.dict[63]));
+        valid = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), digit), _mm256_or_si256(c62, c63));
+
+        __m256i shift = _mm256_and_si256(upper, _mm256_set1_epi8(char(0 - 'A')));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(lower, _mm256_set1_epi8(char(26 - 'a'))));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(digit, _mm256_set1_epi8(char(52 - '0'))));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(c62, _mm256_set1_epi8(char(62 - t.dict[62]))));
+        shift = _mm256_or_si256(shift, _mm256_and_si256(c63, _mm256_set1_epi8(char(63 - t.dict[63]))));
+        return _mm256_add_epi8(c, shift);
+    }
+
+    // packs each 128-bit lane like pack_sse41 and moves the 24 bytes to the low end
+    CT_BASE64_TARGET("avx2")
+    inline __m256i pack_avx2(__m256i idx) {
+        const __m256i merged = _mm256_maddubs_epi16(idx, _mm256_set1_epi32(0x01400140));
+        const __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        const __m256i bytes = _mm256_shuffle_epi8(packed, _mm256_broadcastsi128_si256(
+            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+        return _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    }
+
+    // 32 chars -> 24 bytes per iteration (writes 32 bytes)
+    CT_BASE64_TARGET("avx2")
+    inline size_t decode_avx2(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        size_t i = 0;
+        for (; i + 44 <= n; i += 32, out += 24) {
+            __m256i valid;
+            const __m256i idx = indices_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), valid, t);
+            if (_mm256_movemask_epi8(valid) != -1)
+                break;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), pack_avx2(idx));
+        }
+        return i + decode_sse41(in + i, n - i, out, t);
+    }
+
+    //////////// AVX2 Validation ////////////
+
+    CT_BASE64_TARGET("avx2")
+    inline __m256i invalid_avx2(__m256i c, __m256i nibbles) {
+        const __m256i bits = _mm256_broadcastsi128_si256(
+            _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, char(0x80), 0, 0, 0, 0, 0, 0, 0, 0));
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(c, 4), _mm256_set1_epi8(0x0F));
+        const __m256i lo = _mm256_and_si256(c, _mm256_set1_epi8(0x0F));
+        const __m256i hit = _mm256_and_si256(_mm256_shuffle_epi8(nibbles, lo), _mm256_shuffle_epi8(bits, hi));
+        return _mm256_cmpeq_epi8(hit, _mm256_setzero_si256());
+    }
+
+    // 128 chars per test, then 32
+    CT_BASE64_TARGET("avx2")
+    inline size_t validate_avx2(const char* in, size_t n, const Tables& t) {
+        const __m256i nibbles = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.nibbles)));
+        const __m256i* v = reinterpret_cast<const __m256i*>(in);
+        size_t i = 0;
+        for (; i + 128 <= n; i += 128, v += 4) {
+            const __m256i bad = _mm256_or_si256(
+                _mm256_or_si256(invalid_avx2(_mm256_loadu_si256(v), nibbles), invalid_avx2(_mm256_loadu_si256(v + 1), nibbles)),
+                _mm256_or_si256(invalid_avx2(_mm256_loadu_si256(v + 2), nibbles), invalid_avx2(_mm256_loadu_si256(v + 3), nibbles)));
+            if (!_mm256_testz_si256(bad, bad))
+                break;
+        }
+        for (; i + 32 <= n; i += 32) {
+            const unsigned bad = unsigned(_mm256_movemask_epi8(
+                invalid_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), nibbles)));
+            if (bad)
+                return i + unsigned(__builtin_ctz(bad));
+        }
+        return i + validate_sse41(in + i, n - i, t);
+    }
+
+    //////////// SSE4.1 Transcoding ////////////
+
+    // 32 chars per iteration: the chars of the last two symbols are swapped, the others are kept
+    // (invalid_sse41 checks them all)
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t transcode_sse41(const char* in, size_t n, char* out, const TranscodeTables& m) {
+        const __m128i nibbles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m.nibbles));
+        const __m128i from62 = _mm_set1_epi8(m.from62), from63 = _mm_set1_epi8(m.from63);
+        const __m128i to62 = _mm_set1_epi8(m.to62), to63 = _mm_set1_epi8(m.to63);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16));
+            const __m128i bad = _mm_or_si128(invalid_sse41(a, nibbles), invalid_sse41(b, nibbles));
+            if (!_mm_testz_si128(bad, bad))
+                break;
+            const __m128i sa = _mm_blendv_epi8(a, to62, _mm_cmpeq_epi8(a, from62));
+            const __m128i sb = _mm_blendv_epi8(b, to62, _mm_cmpeq_epi8(b, from62));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_blendv_epi8(sa, to63, _mm_cmpeq_epi8(a, from63)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 16), _mm_blendv_epi8(sb, to63, _mm_cmpeq_epi8(b, from63)));
+        }
+        return i + transcode_scalar(in + i, n - i, out + i, m);
+    }
+
+    //////////// AVX2 Whitespace Compaction ////////////
+
+    // 32 chars per iteration, the blocks holding whitespace are compressed by halves
+    CT_BASE64_TARGET("avx2")
+    inline size_t compact_avx2(const char* in, size_t n, char* out) {
+        char* dst = out;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i sp = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8(' ')),
+                                               _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\t')));
+            const __m256i nl = _mm256_or_si256(_mm256_cmpeq_epi8(c, _mm256_set1_epi8('\r')),
+                                               _mm256_cmpeq_epi8(c, _mm256_set1_epi8('\n')));
+            const unsigned spaces = unsigned(_mm256_movemask_epi8(_mm256_or_si256(sp, nl)));
+            if (spaces == 0) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), c);
+                dst += 32;
+            } else {
+                dst += compress_sse41(_mm256_castsi256_si128(c), ~spaces & 0xFFFF, dst);
+                dst += compress_sse41(_mm256_extracti128_si256(c, 1), ~spaces >> 16, dst);
+            }
+        }
+        return size_t(dst - out) + compact_sse41(in + i, n - i, dst);
+    }
+
+    //////////// AVX2 Transcoding ////////////
+
+    // 64 chars per iteration, then 32
+    CT_BASE64_TARGET("avx2")
+    inline size_t transcode_avx2(const char* in, size_t n, char* out, const TranscodeTables& m) {
+        const __m256i nibbles = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(m.nibbles)));
+        const __m256i from62 = _mm256_set1_epi8(m.from62), from63 = _mm256_set1_epi8(m.from63);
+        const __m256i to62 = _mm256_set1_epi8(m.to62), to63 = _mm256_set1_epi8(m.to63);
+        size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32));
+            const __m256i bad = _mm256_or_si256(invalid_avx2(a, nibbles), invalid_avx2(b, nibbles));
+            if (!_mm256_testz_si256(bad, bad))
+                break;
+            const __m256i sa = _mm256_blendv_epi8(a, to62, _mm256_cmpeq_epi8(a, from62));
+            const __m256i sb = _mm256_blendv_epi8(b, to62, _mm256_cmpeq_epi8(b, from62));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_blendv_epi8(sa, to63, _mm256_cmpeq_epi8(a, from63)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 32), _mm256_blendv_epi8(sb, to63, _mm256_cmpeq_epi8(b, from63)));
+        }
+        return i + transcode_sse41(in + i, n - i, out + i, m);
+    }
+
+    //////////// AVX-512 VBMI Encoder ////////////
+
+    // the GCC 12 headers trip this warning on _mm512_undefined_epi32() inside the intrinsics
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+    // 48 input bytes -> 64 output chars per iteration (reads 64 bytes), the dict lookup is a
+    // single 64-entry byte permute
+    CT_BASE64_TARGET("avx512f,avx512bw,avx512vbmi")
+    inline size_t encode_avx512vbmi(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m512i shuf = _mm512_setr_epi32(
+            0x01020001, 0x04050304, 0x07080607, 0x0a0b090a, 0x0d0e0c0d, 0x10110f10, 0x13141213, 0x16171516,
+            0x191a1819, 0x1c1d1b1c, 0x1f201e1f, 0x22232122, 0x25262425, 0x28292728, 0x2b2c2a2b, 0x2e2f2d2e);
+        const __m512i shifts = _mm512_set1_epi64(0x3036242a1016040a);
+        const __m512i lut = _mm512_loadu_si512(t.dict);
+        size_t i = 0;
+        char* dst = out;
+        for (; i + 64 <= n; i += 48, dst += 64) {
+            const __m512i v = _mm512_permutexvar_epi8(shuf, _mm512_loadu_si512(in + i));
+            // the permute only reads the low 6 bits of each index
+            const __m512i idx = _mm512_multishift_epi64_epi8(shifts, v);
+            _mm512_storeu_si512(dst, _mm512_permutexvar_epi8(idx, lut));
+        }
+        // the AVX2 kernels rely on the dict layout
+        return size_t(dst - out) + (t.ranges ? encode_avx2(in + i, n - i, dst, t) : encode_scalar<6>(in + i, n - i, dst, t));
+    }
+
+    //////////// AVX-512 VBMI Decoder ////////////
+
+    // 64 chars -> 48 bytes per iteration (writes 64 bytes), the translation is a permute over the
+    // first 128 entries of the decode LUT
+    CT_BASE64_TARGET("avx512f,avx512bw,avx512vbmi")
+    inline size_t decode_avx512vbmi(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const __m512i lut_lo = _mm512_loadu_si512(t.index);
+        const __m512i lut_hi = _mm512_loadu_si512(t.index + 64);
+        // bytes 2, 1, 0 of each 32-bit lane, 48 bytes in total
+        const __m512i pack = _mm512_setr_epi32(
+            0x06000102, 0x090a0405, 0x0c0d0e08, 0x16101112, 0x191a1415, 0x1c1d1e18, 0x26202122, 0x292a2425,
+            0x2c2d2e28, 0x36303132, 0x393a3435, 0x3c3d3e38, 0, 0, 0, 0);
+        size_t i = 0;
+        for (; i + 88 <= n; i += 64, out += 48) {
+            const __m512i c = _mm512_loadu_si512(in + i);
+            const __m512i idx = _mm512_permutex2var_epi8(lut_lo, c, lut_hi);
+            // the chars >= 0x80 and the ones mapped to -1 have the sign bit set
+            if (_mm512_movepi8_mask(_mm512_or_si512(idx, c)))
+                break;
+            const __m512i merged = _mm512_maddubs_epi16(idx, _mm512_set1_epi32(0x01400140));
+            const __m512i packed = _mm512_madd_epi16(merged, _mm512_set1_epi32(0x00011000));
+            _mm512_storeu_si512(out, _mm512_permutexvar_epi8(pack, packed));
+        }
+        return i + (t.ranges ? decode_avx2(in + i, n - i, out, t) : decode_scalar<6>(in + i, n - i, out, t));
+    }
+
+    //////////// AVX-512 VBMI Validation ////////////
+
+    // 256 chars per test, then 64; the LUT permute of decode_avx512vbmi, whose results are dropped
+    CT_BASE64_TARGET("avx512f,avx512bw,avx512vbmi")
+    inline size_t validate_avx512vbmi(const char* in, size_t n, const Tables& t) {
+        const __m512i lut_lo = _mm512_loadu_si512(t.index);
+        const __m512i lut_hi = _mm512_loadu_si512(t.index + 64);
+        size_t i = 0;
+        for (; i + 256 <= n; i += 256) {
+            __m512i bad = _mm512_setzero_si512();
+            for (size_t k = 0; k < 256; k += 64) {
+                const __m512i c = _mm512_loadu_si512(in + i + k);
+                bad = _mm512_or_si512(bad, _mm512_or_si512(_mm512_permutex2var_epi8(lut_lo, c, lut_hi), c));
+            }
+            if (_mm512_movepi8_mask(bad))
+                break;
+        }
+        for (; i + 64 <= n; i += 64) {
+            const __m512i c = _mm512_loadu_si512(in + i);
+            const uint64_t bad = _mm512_movepi8_mask(_mm512_or_si512(_mm512_permutex2var_epi8(lut_lo, c, lut_hi), c));
+            if (bad)
+                return i + size_t(__builtin_ctzll(bad));
+        }
+        return i + validate_avx2(in + i, n - i, t);
+    }
+
+    //////////// AVX-512 VBMI Transcoding ////////////
+
+    // any pair of alphabets: a permute over the first 128 entries of the map, whose 0 entries and the
+    // chars >= 0x80 stop the loop
+    CT_BASE64_TARGET("avx512f,avx512bw,avx512vbmi")
+    inline size_t transcode_avx512vbmi(const char* in, size_t n, char* out, const TranscodeTables& m) {
+        const __m512i map_lo = _mm512_loadu_si512(m.map);
+        const __m512i map_hi = _mm512_loadu_si512(m.map + 64);
+        size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const __m512i c = _mm512_loadu_si512(in + i);
+            const __m512i s = _mm512_permutex2var_epi8(map_lo, c, map_hi);
+            if (_mm512_movepi8_mask(c) | _mm512_testn_epi8_mask(s, s))
+                break;
+            _mm512_storeu_si512(out + i, s);
+        }
+        return i + (m.ranges ? transcode_avx2(in + i, n - i, out + i, m) : transcode_scalar(in + i, n - i, out + i, m));
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif // CT_BASE64_X86
+
+    //////////// Dispatch ////////////
+
+    // table is the portable one, the pair table codec; scalar is only picked when forced
+    enum class Tier { scalar, table, sse41, avx2, avx512vbmi };
+
+    static constexpr const char* tier_names[] = { "scalar", "table", "sse4.1", "avx2", "avx512vbmi" };
+
+    struct Kernels {
+        Tier tier;
+        // whole groups only, see encode_scalar and decode_scalar
+        size_t (*encode)(const uint8_t* in, size_t n, char* out, const Tables& t);
+        // @p out may be @p in: a group gives fewer bytes than chars, and every store (overrun included)
+        // ends before the next chars read, which keeps decode_inplace safe
+        size_t (*decode)(const char* in, size_t n, uint8_t* out, const Tables& t);
+        // see compact_scalar
+        size_t (*compact)(const char* in, size_t n, char* out);
+        // see validate_scalar
+        size_t (*validate)(const char* in, size_t n, const Tables& t);
+    };
+
+    // cpuid plus the OS support of the extended register state (xgetbv)
+    inline bool supported(Tier tier) {
+#ifdef CT_BASE64_X86
+        unsigned eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+            return tier <= Tier::table;
+        const bool sse41 = (ecx & bit_SSSE3) && (ecx & bit_SSE4_1);
+        uint64_t xcr0 = 0;
+        if (ecx & bit_OSXSAVE) {
+            unsigned lo, hi;
+            __asm__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            xcr0 = uint64_t(hi) << 32 | lo;
+        }
+        unsigned ebx7 = 0, ecx7 = 0;
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            ebx7 = ebx;
+            ecx7 = ecx;
+        }
+        // XMM/YMM state, plus opmask/ZMM state for AVX-512
+        const bool avx2 = sse41 && (xcr0 & 0x06) == 0x06 && (ebx7 & bit_AVX2);
+        const bool vbmi = avx2 && (xcr0 & 0xE6) == 0xE6 &&
+                          (ebx7 & bit_AVX512F) && (ebx7 & bit_AVX512BW) && (ecx7 & bit_AVX512VBMI);
+        switch (tier) {
+            case Tier::avx512vbmi: return vbmi;
+            case Tier::avx2:       return avx2;
+            case Tier::sse41:      return sse41;
+            default:               return true;
+        }
+#else
+        return tier <= Tier::table;
+#endif
+    }
+
+    template<unsigned bits>
+    inline Kernels scalar_kernels() {
+        return { Tier::scalar, encode_scalar<bits>, decode_scalar<bits>, compact_scalar, validate_scalar };
+    }
+
+    // the kernels of the alphabets of @p bits bits up to a tier: the scalar ones, unless a specialization
+    // plugs in SIMD ones (for Base64 below, for Base32 and Base16 in ct-radix-rt.h)
+    template<unsigned bits>
+    struct tier_kernels {
+        template<class A>
+        static Kernels of(Tier) { return scalar_kernels<bits>(); }
+    };
+
+    template<>
+    struct tier_kernels<6> {
+        static Kernels simd(Tier tier) {
+            switch (tier) {
+#ifdef CT_BASE64_X86
+                // AVX-512 VBMI has no byte compress (that is VBMI2), the AVX2 compaction is used
+                case Tier::avx512vbmi: return { tier, encode_avx512vbmi, decode_avx512vbmi, compact_avx2, validate_avx512vbmi };
+                case Tier::avx2:       return { tier, encode_avx2, decode_avx2, compact_avx2, validate_avx2 };
+                case Tier::sse41:      return { tier, encode_sse41, decode_sse41, compact_sse41, validate_sse41 };
+#endif
+                // the pair tables belong to an alphabet, see of
+                default:               return scalar_kernels<6>();
+            }
+        }
+
+        // with the pair tables of @p A, which stand in for the SIMD kernels below AVX-512 when they
+        // cannot handle its dict layout (and validate_scalar for the SIMD validation)
+        template<class A>
+        static Kernels of(Tier tier) {
+            const Tables& t = tables_of<A>::value;
+            Kernels k = simd(tier);
+            if (!t.ascii)
+                k.validate = validate_scalar;
+            if (tier == Tier::table || (tier != Tier::scalar && tier < Tier::avx512vbmi && !t.ranges))
+                return { Tier::table, encode_pairs<A>, decode_pairs<A>, k.compact, k.validate };
+            return k;
+        }
+    };
+
+    // the kernels of @p A up to @p tier
+    template<class A>
+    inline Kernels kernels_of(Tier tier) {
+        return tier_kernels<tables_of<A>::value.bits>::template of<A>(tier);
+    }
+
+    // best tier of the host, CT_BASE64_TIER=<tier name> forces a lower one (for testing)
+    inline Tier select_tier() {
+        Tier best = Tier::avx512vbmi;
+        while (best != Tier::scalar && !supported(best))
+            best = Tier(int(best) - 1);
+        if (const char* forced = std::getenv("CT_BASE64_TIER")) {
+            for (int t = 0; t <= int(best); ++t) {
+                if (std::strcmp(forced, tier_names[t]) == 0)
+                    return Tier(t);
+            }
+        }
+        return best;
+    }
+
+    // chosen once per alphabet, on first use
+    template<class A>
+    inline const Kernels& kernels() {
+        static const Tier tier = select_tier();
+        static const Kernels selected = kernels_of<A>(tier);
+        return selected;
+    }
+
+    struct Transcoder {
+        Tier tier;
+        // see transcode_scalar
+        size_t (*transcode)(const char* in, size_t n, char* out, const TranscodeTables& m);
+    };
+
+    // the SSE4.1/AVX2 kernels for ranges alphabets only, the scalar one for the table tier
+    template<class From, class To>
+    inline Transcoder transcoder_of(Tier tier) {
+        const bool ranges = transcode_tables_of<From, To>::value.ranges;
+        switch (tier) {
+#ifdef CT_BASE64_X86
+            case Tier::avx512vbmi: return { tier, transcode_avx512vbmi };
+            case Tier::avx2:       if (ranges) return { tier, transcode_avx2 }; break;
+            case Tier::sse41:      if (ranges) return { tier, transcode_sse41 }; break;
+#endif
+            default:               break;
+        }
+        return { Tier::scalar, transcode_scalar };
+    }
+
+    template<class From, class To>
+    inline const Transcoder& transcoder() {
+        static const Transcoder selected = transcoder_of<From, To>(select_tier());
+        return selected;
+    }
+
+    inline size_t encode(const Kernels& k, const Tables& t, bool padding, const uint8_t* in, size_t n, char* out) {
+        const size_t whole = n - n % t.group_bytes;
+        const size_t written = k.encode(in, whole, out, t);
+        return written + encode_tail(in + whole, n - whole, out + written, t, padding);
+    }
+
+    inline size_t line_break(char* out, bool crlf) {
+        if (crlf)
+            *out++ = '\r';
+        *out = '\n';
+        return crlf ? 2 : 1;
+    }
+
+    // one line of @p cols chars (a multiple of the group chars) at a time, each one followed by its line break
+    inline size_t encode_lines(const Kernels& k, const Tables& t, bool padding, const uint8_t* in, size_t n, char* out,
+                               size_t cols, bool crlf) {
+        if (cols == 0)
+            return encode(k, t, padding, in, n, out);
+        const size_t line = cols / t.group_chars * t.group_bytes;
+        char* dst = out;
+        for (size_t i = 0; i < n; i += line) {
+            dst += encode(k, t, padding, in + i, n - i < line ? n - i : line, dst);
+            dst += line_break(dst, crlf);
+        }
+        return size_t(dst - out);
+    }
+
+    inline size_t decode_error(size_t* error, size_t offset) {
+        if (error)
+            *error = offset;
+        return npos;
+    }
+
+    // same acceptance rules as checks::is_encoding_v (for Base64: with padding, the length is a multiple
+    // of 4 and '=' may only fill the last one or two positions; without, the last group has 2 to 4 chars);
+    // a bad char is reported at its offset, a bad length at the first char of the last group
+    inline size_t decode(const Kernels& k, const Tables& t, bool padding, const char* in, size_t n, uint8_t* out,
+                         size_t* error) {
+        const size_t chars = t.group_chars;
+        const size_t full = n - n % chars;
+        // the last group is the only one that may be short or padded, it is decoded apart
+        const size_t body = (padding && full == n && n != 0) ? n - chars : full;
+
+        const size_t i = k.decode(in, body, out, t);
+        if (i < body)
+            return decode_error(error, i + find_invalid(in + i, chars, t));
+        if (n == body)
+            return body / chars * t.group_bytes;
+
+        const char* g = in + body;
+        const size_t size = (padding && full == n) ? unpadded_length(t, g, chars) : n - body;
+        const size_t bad = find_invalid(g, size, t);
+        if (bad < size)
+            return decode_error(error, body + bad);
+        if ((padding && full != n) || (size != chars && !is_tail(t, size)))
+            return decode_error(error, body);
+
+        // up to a whole group, its padding taken out
+        uint64_t s = 0;
+        for (size_t j = 0; j < size; ++j)
+            s = s << t.bits | uint64_t(t.index[uint8_t(g[j])]);
+        const size_t bytes = size * t.bits / 8;
+        s >>= size * t.bits - bytes * 8;
+        uint8_t* dst = out + body / chars * t.group_bytes;
+        for (size_t j = 0; j < bytes; ++j)
+            dst[j] = uint8_t(s >> (8 * (bytes - 1 - j)));
+        return body / chars * t.group_bytes + bytes;
+    }
+
+    // decode() over @p buf itself, the output is never ahead of the input (see Kernels::decode); the
+    // chars past the decoded bytes are left unspecified, on errors too
+    inline size_t decode_inplace(const Kernels& k, const Tables& t, bool padding, char* buf, size_t n,
+                                 size_t* error) {
+        return decode(k, t, padding, buf, n, reinterpret_cast<uint8_t*>(buf), error);
+    }
+
+    // the part of validate() past the whole groups of @p body chars
+    inline size_t validate_last(const Tables& t, bool padding, const char* in, size_t n, size_t body) {
+        const size_t full = n & ~size_t(3);
+        if (padding ? full != n : n - full == 1) {
+            const size_t bad = find_invalid(in + full, n - full, t);
+            return full + (bad < n - full ? bad : 0);
+        }
+        const char* g = in + body;
+        size_t size = n - body;
+        if (padding && size == 4)
+            size -= (g[3] == '=') ? ((g[2] == '=') ? 2 : 1) : 0;
+        const size_t bad = find_invalid(g, size, t);
+        return bad < size ? body + bad : npos;
+    }
+
+    // decode() without the output: offset of the first bad char (by the same rules), npos for a valid
+    // encoding
+    inline size_t validate(const Kernels& k, const Tables& t, bool padding, const char* in, size_t n) {
+        const size_t full = n & ~size_t(3);
+        const size_t body = (padding && full == n && n != 0) ? n - 4 : full;
+        const size_t i = k.validate(in, body, t);
+        return i < body ? i : validate_last(t, padding, in, n, body);
+    }
+
+    // validate() that writes the chars over to the target alphabet of @p m on the way, '=' kept; returns
+    // @p n, or npos with the offset of the first bad char in @p error (the output is then partial)
+    inline size_t transcode(const Transcoder& x, const TranscodeTables& m, const Tables& from, bool padding,
+                            const char* in, size_t n, char* out, size_t* error) {
+        const size_t full = n & ~size_t(3);
+        const size_t body = (padding && full == n && n != 0) ? n - 4 : full;
+        const size_t i = x.transcode(in, body, out, m);
+        if (i < body)
+            return decode_error(error, i);
+        const size_t bad = validate_last(from, padding, in, n, body);
+        if (bad != npos)
+            return decode_error(error, bad);
+        for (size_t j = body; j < n; ++j)
+            out[j] = in[j] == '=' ? '=' : m.map[uint8_t(in[j])];
+        return n;
+    }
+
+    // decode() over the input with its whitespace (is_space) taken out, without a copy of the input:
+    // the blocks are compacted into a window on the stack, whose whole groups are decoded as soon as
+    // it fills up, all but the last one (which may be the padded one). Error offsets refer to @p in
+    inline size_t decode_relaxed(const Kernels& k, const Tables& t, bool padding, const char* in, size_t n,
+                                 uint8_t* out, size_t* error) {
+        static constexpr size_t block = 4096;
+        char window[block + 64];
+        uint8_t* dst = out;
+        // chars in the window, chars decoded before it and the first bad one (all after compaction)
+        size_t fill = 0, done = 0, bad = npos;
+        for (size_t i = 0; i < n; i += block) {
+            fill += k.compact(in + i, n - i < block ? n - i : block, window + fill);
+            if (fill <= 4)
+                continue;
+            const size_t whole = (fill - 4) & ~size_t(3);
+            const size_t used = k.decode(window, whole, dst, t);
+            if (used < whole) {
+                bad = done + used + find_invalid(window + used, 4, t);
+                break;
+            }
+            dst += whole / 4 * 3;
+            done += whole;
+            fill -= whole;
+            std::memmove(window, window + whole, fill);
+        }
+        if (bad == npos) {
+            size_t e = 0;
+            const size_t size = decode(k, t, padding, window, fill, dst, &e);
+            if (size != npos)
+                return size_t(dst - out) + size;
+            bad = done + e;
+        }
+        // back to an offset in @p in
+        size_t at = 0;
+        for (size_t kept = 0; at < n; ++at) {
+            if (!is_space(in[at]) && kept++ == bad)
+                break;
+        }
+        return decode_error(error, at);
+    }
+
+    // exact output size of a valid encoding
+    inline size_t decoded_size(const char* in, size_t n, bool padding) {
+        if (padding && n >= 4 && n % 4 == 0)
+            n -= (in[n - 1] == '=') ? ((in[n - 2] == '=') ? 2 : 1) : 0;
+        return n * 3 / 4;
+    }
+
+    //////////// String Output ////////////
+
+    // grows @p s by @p most chars, lets @p write fill them and cuts @p s to what was written
+    // (npos: nothing); the new chars are not zeroed first where the library allows it
+    template<class Write>
+    inline size_t append(std::string& s, size_t most, Write write) {
+        const size_t size = s.size();
+        size_t written = 0;
+#ifdef __cpp_lib_string_resize_and_overwrite
+        s.resize_and_overwrite(size + most, [&](char* data, size_t) {
+            written = write(data + size);
+            return written == npos ? size : size + written;
+        });
+#else
+        s.resize(size + most);
+        written = write(&s[size]);
+        s.resize(written == npos ? size : size + written);
+#endif
+        return written;
+    }
+
+    //////////// Self-test ////////////
+
+    // a compile-time encoding and its payload
+    struct TestVector {
+        const char* plain;
+        size_t size;
+        const char* text;
+    };
+
+    // the checks a codec may add to run_self_test, none here
+    struct SelfTestHooks {
+        // a byte of the pseudo-random payloads
+        static uint8_t byte(uint32_t seed) { return uint8_t(seed); }
+        template<class K>
+        bool vector(const K&, const TestVector&) const { return true; }
+        // after the round trip of @p plain, encoded into [enc, enc+n) (enc has room for one more char)
+        template<class K>
+        bool clean(const K&, const uint8_t*, size_t, char*, size_t) const { return true; }
+        // after the offset of the bad char at @p at has been checked
+        template<class K>
+        bool corrupted(const K&, const char*, size_t, size_t) const { return true; }
+    };
+
+    // the tier loop of the self-tests of every codec: each tier the host supports runs @p vectors, then
+    // pseudo-random buffers of every length up to 512 bytes against the scalar tier, clean and with
+    // Codec::bad_char at a pseudo-random offset below corruptible(), which every tier must report there.
+    // @p codec gives the kernels of a tier and drives them: kernels(tier), encode(k, in, n, out) and
+    // decode(k, in, n, out, error), plus the hooks of SelfTestHooks
+    template<class Codec, size_t N>
+    inline bool run_self_test(const Codec& codec, const TestVector (&vectors)[N]) {
+        char enc[1280];
+        uint8_t dec[1280], ref[1280];
+
+        const auto scalar = codec.kernels(Tier::scalar);
+        for (int tier = 0; tier <= int(Tier::avx512vbmi); ++tier) {
+            const auto k = codec.kernels(Tier(tier));
+            if (!supported(Tier(tier)) || k.tier != Tier(tier))
+                continue;
+            for (const TestVector& v : vectors) {
+                const size_t n = std::strlen(v.text);
+                if (codec.encode(k, reinterpret_cast<const uint8_t*>(v.plain), v.size, enc) != n ||
+                    std::memcmp(enc, v.text, n) != 0)
+                    return false;
+                if (codec.decode(k, v.text, n, dec, nullptr) != v.size || std::memcmp(dec, v.plain, v.size) != 0)
+                    return false;
+                if (!codec.vector(k, v))
+                    return false;
+            }
+
+            uint32_t seed = 2463534242u;
+            uint8_t plain[512];
+            for (size_t size = 0; size <= sizeof(plain); ++size) {
+                for (size_t j = 0; j < size; ++j) {
+                    seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+                    plain[j] = codec.byte(seed);
+                }
+                const size_t n = codec.encode(k, plain, size, enc);
+                if (n != codec.encode(scalar, plain, size, reinterpret_cast<char*>(ref)) ||
+                    std::memcmp(enc, ref, n) != 0)
+                    return false;
+                if (codec.decode(k, enc, n, dec, nullptr) != size || std::memcmp(dec, plain, size) != 0)
+                    return false;
+                if (!codec.clean(k, plain, size, enc, n))
+                    return false;
+                if (n == 0)
+                    continue;
+                // a bad char must be reported at the same offset by every tier
+                const size_t at = seed % codec.corruptible(enc, n);
+                const char saved = enc[at];
+                enc[at] = Codec::bad_char;
+                size_t error = 0, expected = 0;
+                if (codec.decode(k, enc, n, dec, &error) != npos ||
+                    codec.decode(scalar, enc, n, ref, &expected) != npos || error != expected || error != at ||
+                    !codec.corrupted(k, enc, n, at))
+                    return false;
+                enc[at] = saved;
+            }
+        }
+        return true;
+    }
+
+    // run_self_test for the codecs of Tables, BasicBase64 and BasicRadix
+    template<class A, bool padding>
+    struct TablesSelfTest : SelfTestHooks {
+        static constexpr char bad_char = '!';
+
+        static const Tables& tables() { return tables_of<A>::value; }
+
+        Kernels kernels(Tier tier) const { return kernels_of<A>(tier); }
+        size_t encode(const Kernels& k, const uint8_t* in, size_t n, char* out) const {
+            return rt::encode(k, tables(), padding, in, n, out);
+        }
+        size_t decode(const Kernels& k, const char* in, size_t n, uint8_t* out, size_t* error) const {
+            return rt::decode(k, tables(), padding, in, n, out, error);
+        }
+        // ahead of any '=', which would be the first bad char otherwise
+        size_t corruptible(const char* enc, size_t n) const { return unpadded_length(tables(), enc, n); }
+    };
+
+    // @p hooks run on the RFC 4648 vectors and a few more, which @p Codec encodes at compile time
+    template<class Codec, class Hooks>
+    inline bool run_tables_self_test(const Hooks& hooks) {
+#define CT_BASE64_VECTOR(s) { s, sizeof(s) - 1, Codec::encode(CTSTRING(s)).data }
+        const TestVector vectors[] = {
+            CT_BASE64_VECTOR(""),
+            CT_BASE64_VECTOR("f"),
+            CT_BASE64_VECTOR("fo"),
+            CT_BASE64_VECTOR("foo"),
+            CT_BASE64_VECTOR("foob"),
+            CT_BASE64_VECTOR("fooba"),
+            CT_BASE64_VECTOR("foobar"),
+            CT_BASE64_VECTOR("\xfb\xef\xff\xfb\xff\xbf\x00\x10\x83\x10\x51\x87"),
+            CT_BASE64_VECTOR("The quick brown fox jumps over the lazy dog, then the lazy dog wakes up and "
+                             "chases the quick brown fox \xfb\xff\xbf\xfe all the way back over the hill."),
+        };
+#undef CT_BASE64_VECTOR
+        return run_self_test(hooks, vectors);
+    }
+
+    // TablesSelfTest plus validate, decode_inplace, the streaming decoder and the transcoding into
+    // RFC 4648 base64 (against its scalar encoder)
+    template<class A, bool padding>
+    struct Base64SelfTest : TablesSelfTest<A, padding> {
+        using TablesSelfTest<A, padding>::tables;
+        using TablesSelfTest<A, padding>::decode;
+
+        static Transcoder transcoder(const Kernels& k) { return transcoder_of<A, alphabet::Standard>(k.tier); }
+
+        bool vector(const Kernels& k, const TestVector& v) const {
+            return validate(k, tables(), padding, v.text, std::strlen(v.text)) == npos;
+        }
+
+        bool clean(const Kernels& k, const uint8_t* plain, size_t size, char* enc, size_t n) const {
+            const TranscodeTables& m = transcode_tables_of<A, alphabet::Standard>::value;
+            char copy[1280], ref[1280];
+            uint8_t dec[1280];
+            std::memcpy(copy, enc, n);
+            if (decode_inplace(k, tables(), padding, copy, n, nullptr) != size || std::memcmp(copy, plain, size) != 0)
+                return false;
+            if (rt::transcode(transcoder(k), m, tables(), padding, enc, n, copy, nullptr) != n ||
+                rt::encode(kernels_of<alphabet::Standard>(Tier::scalar), tables_of<alphabet::Standard>::value, padding, plain, size, ref) != n ||
+                std::memcmp(copy, ref, n) != 0)
+                return false;
+            // the streaming decoder reports the chars after a padded group where decode does, however
+            // the input is split
+            if (n == 0 || !padding || enc[n - 1] != '=')
+                return true;
+            enc[n] = 'A';
+            size_t expected = 0;
+            decode(k, enc, n + 1, dec, &expected);
+            const size_t splits[] = { n + 1, n, size / 2 };
+            for (size_t split : splits) {
+                typename BasicBase64<A, padding>::Decoder decoder;
+                decoder.update(enc, split, dec);
+                decoder.update(enc + split, n + 1 - split, dec);
+                if (decoder.error() != expected)
+                    return false;
+            }
+            return true;
+        }
+
+        bool corrupted(const Kernels& k, const char* enc, size_t n, size_t at) const {
+            const TranscodeTables& m = transcode_tables_of<A, alphabet::Standard>::value;
+            char copy[1280];
+            size_t in_place = 0, transcoded = 0;
+            std::memcpy(copy, enc, n);
+            return validate(k, tables(), padding, enc, n) == at &&
+                   decode_inplace(k, tables(), padding, copy, n, &in_place) == npos && in_place == at &&
+                   rt::transcode(transcoder(k), m, tables(), padding, enc, n, copy, &transcoded) == npos &&
+                   transcoded == at;
+        }
+    };
+
+    template<class A, bool padding>
+    inline bool self_test() {
+        return run_tables_self_test<BasicBase64<A, padding> >(Base64SelfTest<A, padding>());
+    }
+}
+}
+
+#endif // CT_BASE_64_HPP
@@ -0,0 +1,160 @@
+/**
+ * Compile-time lib
+ * @file    ct-base64-runtime.hpp
+ * @brief   The SIMD runtime codec of ct-base64.hpp
+ * @author  Douglas Oliveira
+ * @date    2026-10-16
+ *
+ * Defines the runtime members of BasicBase64 (and Encoder, Decoder, the multi-threaded, batched and
+ * streambuf codecs, embedded blobs); ct-base64.hpp alone only forwards them to impl::rt::Runtime, so that
+ * the compile-time codec does not pay for the intrinsics and the threading headers.
+ *
+ * @note !!C++14 dependent module!!
+ */
+
+#ifndef CT_BASE_64_RUNTIME_HPP
+#define CT_BASE_64_RUNTIME_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ct-base64.hpp"
+
+// the runtime kernels are built with per-function target attributes, so no -m flags are required
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#include <cpuid.h>
+#define CT_BASE64_X86
+#define CT_BASE64_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+// a ct::embedded_blob, decoded at runtime on first access
+#define CT_BASE64_BLOB(string_b64_literal) \
+    ct::make_embedded_blob(CTSTRING(string_b64_literal))
+
+namespace ct
+{
+
+#include "ct-base64-rt.h"
+#include "ct-base64-stream.h"
+#include "ct-base64-parallel.h"
+#include "ct-base64-batch.h"
+#include "ct-base64-streambuf.h"
+#include "ct-base64-blob.h"
+
+namespace impl
+{
+namespace rt
+{
+    // the bodies of the runtime members of BasicBase64<A, P>
+    template <class A, bool P>
+    struct Runtime<A, P, true> {
+        typedef BasicBase64<A, P> Codec;
+
+        static size_t encode(const void* data, size_t size, char* out) {
+            return rt::encode(kernels<A>(), tables_of<A>::value, P, static_cast<const uint8_t*>(data), size, out);
+        }
+
+        static size_t decode(const char* b64, size_t size, void* out, size_t* error) {
+            return rt::decode(kernels<A>(), tables_of<A>::value, P, b64, size, static_cast<uint8_t*>(out), error);
+        }
+
+        static size_t decode_relaxed(const char* b64, size_t size, void* out, size_t* error) {
+            return rt::decode_relaxed(kernels<A>(), tables_of<A>::value, P, b64, size, static_cast<uint8_t*>(out),
+                                      error);
+        }
+
+        static size_t decode_inplace(char* b64, size_t size, size_t* error) {
+            return rt::decode_inplace(kernels<A>(), tables_of<A>::value, P, b64, size, error);
+        }
+
+        static bool validate(const char* b64, size_t size, size_t* error) {
+            const size_t at = rt::validate(kernels<A>(), tables_of<A>::value, P, b64, size);
+            if (at != npos)
+                decode_error(error, at);
+            return at == npos;
+        }
+
+        template <class To>
+        static size_t transcode(const char* b64, size_t size, char* out, size_t* error) {
+            static_assert(tables_of<To>::value.valid,
+                          "BasicBase64::transcode: the target alphabet needs 64 distinct symbols other than '='");
+            return rt::transcode(transcoder<A, To>(), transcode_tables_of<A, To>::value, tables_of<A>::value, P,
+                                 b64, size, out, error);
+        }
+
+        static size_t encode(const void* data, size_t size, char* out, LineWrap wrap) {
+            return encode_lines(kernels<A>(), tables_of<A>::value, P, static_cast<const uint8_t*>(data), size, out,
+                                wrap.cols & ~size_t(3), wrap.crlf);
+        }
+
+        static size_t decode_into(const char* b64, size_t size, void* out, size_t capacity, size_t* error) {
+            if (capacity < decoded_size(b64, size, P))
+                return decode_error(error, npos);
+            return decode(b64, size, out, error);
+        }
+
+        static size_t encode(const void* data, size_t size, std::string& out) {
+            return append(out, Codec::encoded_size(size), [&](char* dst) { return encode(data, size, dst); });
+        }
+
+        static size_t decode(const char* b64, size_t size, std::string& out, size_t* error) {
+            return append(out, Codec::decoded_max_size(size), [&](char* dst) { return decode(b64, size, dst, error); });
+        }
+
+#ifdef CT_BASE64_IOV
+        static size_t encode_iov(const iovec* iov, int count, char* out) {
+            typename Codec::Encoder encoder;
+            const size_t n = encoder.update(iov, count, out);
+            return n + encoder.finish(out + n);
+        }
+#endif
+
+        static size_t encode(const void* data, size_t size, char* out, const Parallel& parallel) {
+            return rt::encode(kernels<A>(), tables_of<A>::value, P, static_cast<const uint8_t*>(data), size, out,
+                              parallel);
+        }
+
+        static size_t decode(const char* b64, size_t size, void* out, size_t* error, const Parallel& parallel) {
+            return rt::decode(kernels<A>(), tables_of<A>::value, P, b64, size, static_cast<uint8_t*>(out), error,
+                              parallel);
+        }
+
+        static size_t decode_relaxed(const char* b64, size_t size, void* out, size_t* error,
+                                     const Parallel& parallel) {
+            return rt::decode_relaxed(kernels<A>(), tables_of<A>::value, P, b64, size, static_cast<uint8_t*>(out),
+                                      error, parallel);
+        }
+
+        static size_t encode_batch(const Slice* in, size_t count, char* arena, size_t* offsets) {
+            return rt::encode_batch(kernels<A>(), tables_of<A>::value, P, in, count, arena, offsets);
+        }
+
+        static size_t decode_batch(const Slice* in, size_t count, void* arena, size_t* offsets, size_t* errors) {
+            return rt::decode_batch(kernels<A>(), tables_of<A>::value, P, in, count, static_cast<uint8_t*>(arena),
+                                    offsets, errors);
+        }
+
+        static const char* tier() {
+            return tier_names[int(kernels<A>().tier)];
+        }
+
+        static bool self_test() {
+            return rt::self_test<A, P>();
+        }
+    };
+}
+}
+
+}
+
+#endif // CT_BASE_64_RUNTIME_HPP
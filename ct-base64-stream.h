@@ -0,0 +1,182 @@
+#ifdef CT_BASE_64_HPP
+
+//////////// Streaming Encoder ////////////
+
+// the 3-byte groups split between update() calls are carried over (0-2 bytes), and so is the
+// column of the current line when the output is line-wrapped
+template <class Alphabet, bool Padding>
+class BasicBase64<Alphabet, Padding>::Encoder {
+public:
+    Encoder() = default;
+    // line-wrapped output, the line breaks are written as the lines are encoded
+    explicit Encoder(LineWrap wrap) : cols(wrap.cols & ~size_t(3)), crlf(wrap.crlf) { }
+
+    // @p out must have room for encoded_size(size + 2) chars, or encoded_size(size + 2, wrap) when
+    // line-wrapped; returns the number of chars written
+    size_t update(const void* data, size_t size, char* out) {
+        const uint8_t* in = static_cast<const uint8_t*>(data);
+        char* dst = out;
+        if (npending) {
+            while (npending < 3 && size) {
+                pending[npending++] = *in++;
+                --size;
+            }
+            if (npending < 3)
+                return 0;
+            dst += groups(pending, 3, dst);
+            npending = 0;
+        }
+        const size_t whole = size - size % 3;
+        dst += groups(in, whole, dst);
+        for (size_t i = whole; i < size; ++i)
+            pending[npending++] = in[i];
+        return size_t(dst - out);
+    }
+
+#ifdef CT_BASE64_IOV
+    // update() over the @p count fragments of @p iov in turn
+    // @p out must have room for encoded_size(size + 2) chars (or encoded_size(size + 2, wrap)), size
+    // being their total length; returns the number of chars written
+    size_t update(const iovec* iov, int count, char* out) {
+        char* dst = out;
+        for (int i = 0; i < count; ++i)
+            dst += update(iov[i].iov_base, iov[i].iov_len, dst);
+        return size_t(dst - out);
+    }
+#endif
+
+    // writes the last (short) group, at most 4 chars plus the last line break, and gets ready for
+    // a new message
+    size_t finish(char* out) {
+        size_t n = impl::rt::encode_tail(pending, npending, out, impl::tables_of<Alphabet>::value, Padding);
+        if (cols && column + n)
+            n += impl::rt::line_break(out + n, crlf);
+        npending = 0;
+        column = 0;
+        return n;
+    }
+
+private:
+    // whole groups, a line break after every cols chars
+    size_t groups(const uint8_t* in, size_t n, char* out) {
+        const impl::Tables& t = impl::tables_of<Alphabet>::value;
+        const impl::rt::Kernels& k = impl::rt::kernels<Alphabet>();
+        if (cols == 0)
+            return k.encode(in, n, out, t);
+        char* dst = out;
+        while (n) {
+            const size_t room = (cols - column) / 4 * 3;
+            const size_t count = n < room ? n : room;
+            const size_t chars = k.encode(in, count, dst, t);
+            dst += chars;
+            in += count;
+            n -= count;
+            column += chars;
+            if (column == cols) {
+                dst += impl::rt::line_break(dst, crlf);
+                column = 0;
+            }
+        }
+        return size_t(dst - out);
+    }
+
+    uint8_t pending[3];
+    size_t npending = 0;
+    size_t cols = 0;
+    bool crlf = false;
+    // chars of the current line
+    size_t column = 0;
+};
+
+//////////// Streaming Decoder ////////////
+
+// the 4-char groups split between update() calls are carried over (0-3 chars), a padded group
+// ends the message; error offsets count from the start of the message
+template <class Alphabet, bool Padding>
+class BasicBase64<Alphabet, Padding>::Decoder {
+public:
+    // @p out must have room for 3 * ((size + 3) / 4) bytes; returns the number of bytes written,
+    // or npos once the input is known not to be a valid encoding
+    size_t update(const char* b64, size_t size, void* out) {
+        if (first_error != npos)
+            return npos;
+        uint8_t* dst = static_cast<uint8_t*>(out);
+        if (size && padded)
+            return fail(padding);
+        if (npending) {
+            while (npending < 4 && size) {
+                pending[npending++] = *b64++;
+                --size;
+            }
+            if (npending < 4)
+                return 0;
+            npending = 0;
+            const size_t n = groups(pending, 4, dst);
+            if (n == npos)
+                return npos;
+            if (size && padded)
+                return fail(padding);
+            dst += n;
+        }
+        const size_t whole = size & ~size_t(3);
+        const size_t n = groups(b64, whole, dst);
+        if (n == npos)
+            return npos;
+        if (whole < size && padded)
+            return fail(padding);
+        for (size_t i = whole; i < size; ++i)
+            pending[npending++] = b64[i];
+        return size_t(dst + n - static_cast<uint8_t*>(out));
+    }
+
+    // ends the message: without padding the last 2 or 3 chars are decoded here (at most 2 bytes);
+    // returns the number of bytes written, or npos if the message was not a complete, valid encoding
+    size_t finish(void* out) {
+        if (first_error != npos || npending == 0)
+            return first_error == npos ? 0 : npos;
+        const impl::Tables& t = impl::tables_of<Alphabet>::value;
+        size_t e = 0;
+        const size_t n = impl::rt::decode(impl::rt::kernels<Alphabet>(), t, Padding, pending, npending,
+                                          static_cast<uint8_t*>(out), &e);
+        return n == npos ? fail(offset + e) : n;
+    }
+
+    // offset of the first bad char, npos if none was found
+    size_t error() const { return first_error; }
+
+    // gets ready for a new message
+    void reset() { *this = Decoder(); }
+
+private:
+    size_t groups(const char* in, size_t n, uint8_t* out) {
+        if (n == 0)
+            return 0;
+        const impl::Tables& t = impl::tables_of<Alphabet>::value;
+        size_t e = 0;
+        const size_t written = impl::rt::decode(impl::rt::kernels<Alphabet>(), t, Padding, in, n, out, &e);
+        if (written == npos)
+            return fail(offset + e);
+        if (Padding && in[n - 1] == '=') {
+            padded = true;
+            padding = offset + n - (in[n - 2] == '=' ? 2 : 1);
+        }
+        offset += n;
+        return written;
+    }
+
+    size_t fail(size_t at) {
+        if (first_error == npos)
+            first_error = at;
+        return npos;
+    }
+
+    char pending[4];
+    size_t npending = 0;
+    // chars of the message decoded so far
+    size_t offset = 0;
+    bool padded = false;
+    size_t padding = 0;
+    size_t first_error = npos;
+};
+
+#endif // CT_BASE_64_HPP
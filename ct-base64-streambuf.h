@@ -0,0 +1,131 @@
+#ifdef CT_BASE_64_HPP
+
+//////////// Encoding Stream Buffer ////////////
+
+// output filter: the bytes written to it reach @p sink Base64-encoded, through the streaming Encoder;
+// the last group is only written by finish() (or the destructor), sync() flushes the whole groups
+template <class Codec = Base64>
+class base64_ostreambuf : public std::streambuf {
+public:
+    explicit base64_ostreambuf(std::streambuf* sink, size_t buffer_size = default_buffer)
+        : base64_ostreambuf(sink, LineWrap{ 0, false }, buffer_size) { }
+
+    base64_ostreambuf(std::streambuf* sink, LineWrap wrap, size_t buffer_size = default_buffer)
+        : sink(sink), encoder(wrap), in(buffer_size), out(Codec::encoded_size(buffer_size + 2, wrap)) {
+        setp(in.data(), in.data() + in.size());
+    }
+
+    ~base64_ostreambuf() override { finish(); }
+
+    // writes the last group of the message (and its line break), then gets ready for a new one;
+    // returns false if @p sink did not take all the chars
+    bool finish() {
+        const bool drained = drain();
+        const size_t n = encoder.finish(out.data());
+        return put(n) && drained;
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (!drain())
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    // large writes are encoded from the caller's memory, without going through the buffer
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        if (size_t(n) < in.size())
+            return std::streambuf::xsputn(s, n);
+        if (!drain())
+            return 0;
+        for (std::streamsize done = 0; done < n;) {
+            const size_t chunk = std::min(size_t(n - done), in.size());
+            if (!put(encoder.update(s + done, chunk, out.data())))
+                return done;
+            done += std::streamsize(chunk);
+        }
+        return n;
+    }
+
+    int sync() override {
+        return drain() && sink->pubsync() == 0 ? 0 : -1;
+    }
+
+private:
+    static constexpr size_t default_buffer = size_t(48) << 10;
+
+    // encodes the buffered bytes
+    bool drain() {
+        const size_t size = size_t(pptr() - pbase());
+        setp(in.data(), in.data() + in.size());
+        return put(encoder.update(in.data(), size, out.data()));
+    }
+
+    bool put(size_t n) {
+        return sink->sputn(out.data(), std::streamsize(n)) == std::streamsize(n);
+    }
+
+    std::streambuf* sink;
+    typename Codec::Encoder encoder;
+    std::vector<char> in, out;
+};
+
+//////////// Decoding Stream Buffer ////////////
+
+// input filter: reads Base64 from @p source and yields the decoded bytes, through the streaming Decoder;
+// relaxed, it skips the spaces, tabs, CR and LF of the input. A bad input ends the stream early, with
+// error() set to the offset of the first bad char (whitespace excluded, when relaxed)
+template <class Codec = Base64>
+class base64_istreambuf : public std::streambuf {
+public:
+    explicit base64_istreambuf(std::streambuf* source, bool relaxed = false, size_t buffer_size = default_buffer)
+        : source(source), relaxed(relaxed), in(buffer_size), compact(relaxed ? buffer_size + 64 : 0),
+          out(Codec::decoded_max_size(buffer_size) + 3) {
+        setg(out.data(), out.data(), out.data());
+    }
+
+    // offset of the first bad char, npos if none was found
+    size_t error() const { return decoder.error(); }
+
+protected:
+    int_type underflow() override {
+        while (gptr() == egptr() && !done) {
+            const std::streamsize n = source->sgetn(in.data(), std::streamsize(in.size()));
+            size_t size = 0;
+            if (n <= 0) {
+                size = decoder.finish(out.data());
+                done = true;
+            } else {
+                const char* b64 = in.data();
+                size_t chars = size_t(n);
+                if (relaxed) {
+                    // the SIMD compaction writes up to 32 bytes past its output, hence the larger buffer
+                    chars = impl::rt::kernels<typename Codec::alphabet_type>().compact(b64, chars, compact.data());
+                    b64 = compact.data();
+                }
+                size = decoder.update(b64, chars, out.data());
+            }
+            if (size == Codec::npos) {
+                done = true;
+                size = 0;
+            }
+            setg(out.data(), out.data(), out.data() + size);
+        }
+        return gptr() == egptr() ? traits_type::eof() : traits_type::to_int_type(*gptr());
+    }
+
+private:
+    static constexpr size_t default_buffer = size_t(64) << 10;
+
+    std::streambuf* source;
+    bool relaxed;
+    bool done = false;
+    typename Codec::Decoder decoder;
+    std::vector<char> in, compact, out;
+};
+
+#endif // CT_BASE_64_HPP
@@ -0,0 +1,65 @@
+/**
+ * Compile-time lib
+ * @file    ct-base64-test.cpp
+ * @brief   Runs the self-tests of every ct runtime codec, on every kernel tier the host supports
+ * @author  Douglas Oliveira
+ * @date    2026-10-16
+ *
+ * Each codec checks its tiers against the compile-time results and against its scalar tier, on fixed
+ * vectors and on pseudo-random buffers, clean and corrupted (see run_self_test). One line per codec,
+ * exit status 1 if any of them fails.
+ *
+ * build: g++ -std=c++14 -O2 -pthread ct-base64-test.cpp -o ct-base64-test
+ * usage: ct-base64-test
+ */
+
+#include <cstdio>
+
+#include "ct-base64-runtime.hpp"
+#include "ct-radix.hpp"
+#include "ct-base85.hpp"
+
+namespace
+{
+
+struct Test {
+    const char* name;
+    bool (*run)();
+};
+
+const Test tests[] = {
+    { "Base64",             ct::Base64::self_test },
+    { "Base64Std",          ct::Base64Std::self_test },
+    { "Base64Url",          ct::Base64Url::self_test },
+    { "Base64Std unpadded", ct::BasicBase64<ct::alphabet::Standard, false>::self_test },
+    { "Base64Url unpadded", ct::BasicBase64<ct::alphabet::UrlSafe, false>::self_test },
+    { "Base32",             ct::Base32::self_test },
+    { "Base32Hex",          ct::Base32Hex::self_test },
+    { "Base32Crockford",    ct::Base32Crockford::self_test },
+    { "Base16",             ct::Base16::self_test },
+    { "Base16Upper",        ct::Base16Upper::self_test },
+    { "Z85",                ct::Z85::self_test },
+    { "Ascii85",            ct::Ascii85::self_test },
+};
+
+}
+
+int main() {
+    namespace rt = ct::impl::rt;
+
+    std::printf("tiers:");
+    for (int tier = 0; tier <= int(rt::Tier::avx512vbmi); ++tier)
+        if (rt::supported(rt::Tier(tier)))
+            std::printf(" %s", rt::tier_names[tier]);
+    std::printf(" (picked: %s)\n", ct::Base64Std::tier());
+
+    int failed = 0;
+    for (const Test& test : tests) {
+        const bool ok = test.run();
+        std::printf("%-20s %s\n", test.name, ok ? "ok" : "FAILED");
+        failed += !ok;
+    }
+    if (failed)
+        std::fprintf(stderr, "%d of %zu self-tests failed\n", failed, sizeof(tests) / sizeof(tests[0]));
+    return failed ? 1 : 0;
+}
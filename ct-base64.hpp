@@ -1,16 +1,33 @@
 /**
  * Compile-time lib
  * @file    ct-base64.hpp
- * @brief   A compile-time Base64 encoder/decoder
+ * @brief   A compile-time Base64 encoder/decoder (with a SIMD runtime codec)
  * @author  Douglas Oliveira
  * @date    2020-10-01
  *
+ * The runtime members of BasicBase64 forward to impl::rt::Runtime, which only ct-base64-runtime.hpp defines:
+ * calling one without it fails to compile, with a message that names that header.
+ *
  * @note !!C++14 dependent module!!
  */
 
 #ifndef CT_BASE_64_HPP
 #define CT_BASE_64_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <type_traits>
+#if defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#if __has_include(<sys/uio.h>)
+#include <sys/uio.h>
+#define CT_BASE64_IOV
+#endif
+#endif
+
 #include "ct-string.hpp"
 
 // macro helpers to encode/decode string literals at compile-time
@@ -23,6 +40,9 @@
     CT_BASE64_ENCODE(string_literal).data
 #define CT_BASE64_DECODE_RT(string_literal) \
     CT_BASE64_DECODE(string_literal).data
+// binary-safe version: a ct::bytes, whose data is a constexpr std::array<uint8_t, N>
+#define CT_BASE64_DECODE_BYTES(string_b64_literal) \
+    ct::Base64::decode_bytes(CTSTRING(string_b64_literal))
 
 namespace ct
 {
@@ -30,25 +50,287 @@ namespace ct
 typedef char b64char;
 typedef uint8_t index_type;
 
-struct Base64 {
+// alphabet policies: symbols() returns the 64 symbols in index order
+namespace alphabet
+{
+    // the original ct::Base64 alphabet, '@' and '&' as the last two symbols
+    struct Legacy {
+        static constexpr const b64char* symbols() {
+            return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789@&";
+        }
+    };
+    // RFC 4648 base64
+    struct Standard {
+        static constexpr const b64char* symbols() {
+            return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        }
+    };
+    // RFC 4648 base64url, URL and filename safe
+    struct UrlSafe {
+        static constexpr const b64char* symbols() {
+            return "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        }
+    };
+}
+
+// settings of the multi-threaded runtime codec
+struct Parallel {
+    // threads to use, the calling one included; 0 for std::thread::hardware_concurrency()
+    unsigned threads = 0;
+    // inputs shorter than this (in bytes or chars) are transcoded on the calling thread alone
+    size_t threshold = size_t(16) << 20;
+};
+
+// line breaks of the encoded text, one every cols chars and one after the last line
+struct LineWrap {
+    // rounded down to a multiple of 4, so that every line holds whole groups; 0 for a single line
+    size_t cols;
+    bool crlf;
+
+    // RFC 7468 (PEM) and RFC 2045 (MIME) layouts
+    static constexpr LineWrap pem() { return { 64, false }; }
+    static constexpr LineWrap mime() { return { 76, true }; }
+};
+
+// one message of a batch
+struct Slice {
+    const void* data;
+    size_t size;
+};
+
+#include "ct-base64-impl.h"
+
+namespace impl
+{
+namespace rt
+{
+    // the runtime codec of BasicBase64<A, P>, specialized by ct-base64-runtime.hpp
+    template <class A, bool P, bool Included = true>
+    struct Runtime {
+        static_assert(sizeof(A) == 0, "BasicBase64: include ct-base64-runtime.hpp to use the runtime codec");
+    };
+}
+}
+
+// Without padding the last group is cut to 2 or 3 chars and '=' is never accepted
+template <class Alphabet, bool Padding = true>
+struct BasicBase64 {
+    static_assert(impl::tables_of<Alphabet>::value.valid && impl::tables_of<Alphabet>::value.bits == 6,
+                  "BasicBase64: the alphabet needs 64 distinct symbols other than '='");
+
+    typedef Alphabet alphabet_type;
+    static constexpr bool padding = Padding;
+
     // return a compile-time string
     template <char... str>
     static constexpr auto encode(ct::string<str...> s);
+    // return a compile-time string, with a line break after every cols chars and after the last line
+    template <size_t cols, bool crlf, char... str>
+    static constexpr auto encode_lines(ct::string<str...> s);
     // return a compile-time string
     template <char... str>
     static constexpr auto decode(ct::string<str...> s);
+    // return a compile-time string, spaces, tabs, CR and LF in @p s are skipped
+    template <char... str>
+    static constexpr auto decode_relaxed(ct::string<str...> s);
+    // return a compile-time byte string holding the exact payload
+    // (no trailing '\0', no zero bytes from a short last group)
+    template <char... str>
+    static constexpr auto decode_bytes(ct::string<str...> s);
+
+    static constexpr size_t npos = size_t(-1);
+
+    // chars written by the runtime encoder for @p size bytes
+    static constexpr size_t encoded_size(size_t size) { return impl::encoded_length(6, size, Padding); }
+    static constexpr size_t encoded_size(size_t size, LineWrap wrap) {
+        return impl::wrapped_length(encoded_size(size), wrap.cols & ~size_t(3), wrap.crlf ? 2 : 1);
+    }
+    // bytes the runtime decoder may write for @p size chars (exact unless the input is padded)
+    static constexpr size_t decoded_max_size(size_t size) {
+        return size / 4 * 3 + (size % 4 > 1 ? size % 4 - 1 : 0);
+    }
+
+    // (the runtime codec below is defined in ct-base64-runtime.hpp)
+    // runtime encoder, same output as the compile-time one (no '\0' is appended)
+    // @p out must have room for encoded_size(size) chars; returns the number of chars written
+    static size_t encode(const void* data, size_t size, char* out) {
+        return impl::rt::Runtime<Alphabet, Padding>::encode(data, size, out);
+    }
+    // runtime decoder, accepts the same inputs as the compile-time one
+    // @p out must have room for decoded_max_size(size) bytes; returns the exact number of bytes written
+    // (the compile-time decoder keeps the zero bytes of a short last group), or npos if @p b64 is not
+    // a valid encoding, in which case the offset of the first bad char is stored in @p error
+    static size_t decode(const char* b64, size_t size, void* out, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode(b64, size, out, error);
+    }
+    // runtime decoder that skips spaces, tabs, CR and LF (as in PEM or MIME bodies), same rules
+    // otherwise; the error offset refers to @p b64 as given
+    static size_t decode_relaxed(const char* b64, size_t size, void* out, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode_relaxed(b64, size, out, error);
+    }
+    // runtime decoder writing over @p b64, whose first bytes then hold the payload (the decoded size is
+    // returned, the chars after it are left unspecified); same rules and errors as decode
+    static size_t decode_inplace(char* b64, size_t size, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode_inplace(b64, size, error);
+    }
+#ifdef __cpp_lib_span
+    static size_t decode_inplace(std::span<char> b64, size_t* error = nullptr) {
+        return decode_inplace(b64.data(), b64.size(), error);
+    }
+#endif
+    // runtime check, same rules as decode (and checks::is_encoding_v) but nothing is written: false if
+    // @p b64 is not a valid encoding, in which case the offset of the first bad char is stored in @p error
+    static bool validate(const char* b64, size_t size, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::validate(b64, size, error);
+    }
+#ifdef __cpp_lib_span
+    static bool validate(std::span<const char> b64, size_t* error = nullptr) {
+        return validate(b64.data(), b64.size(), error);
+    }
+#endif
+    // rewrites @p b64 into the alphabet of @p To, char for char ('=' kept): the same payload, checked by
+    // the rules of validate, without decoding it
+    // @p out must have room for @p size chars, and may be @p b64; returns @p size, or npos if @p b64 is
+    // not a valid encoding, in which case the offset of the first bad char is stored in @p error
+    template <class To>
+    static size_t transcode(const char* b64, size_t size, char* out, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::template transcode<To>(b64, size, out, error);
+    }
+    // line-wrapped runtime encoder, the line breaks are written as the lines are encoded
+    // @p out must have room for encoded_size(size, wrap) chars; returns the number of chars written
+    static size_t encode(const void* data, size_t size, char* out, LineWrap wrap) {
+        return impl::rt::Runtime<Alphabet, Padding>::encode(data, size, out, wrap);
+    }
+
+    // bounded versions: npos if @p out is smaller than the output, which is then not written
+    // (for decode_into, the exact decoded size and an error offset of npos)
+    static size_t encode_into(const void* data, size_t size, char* out, size_t capacity) {
+        return capacity < encoded_size(size) ? npos : encode(data, size, out);
+    }
+    static size_t decode_into(const char* b64, size_t size, void* out, size_t capacity, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode_into(b64, size, out, capacity, error);
+    }
+#ifdef __cpp_lib_span
+    static size_t encode_into(std::span<const uint8_t> data, std::span<char> out) {
+        return encode_into(data.data(), data.size(), out.data(), out.size());
+    }
+    static size_t decode_into(std::span<const char> b64, std::span<uint8_t> out, size_t* error = nullptr) {
+        return decode_into(b64.data(), b64.size(), out.data(), out.size(), error);
+    }
+#endif
+
+    // append to @p out, grown once to the final size; return the number of chars or bytes appended,
+    // or npos (@p out left as it was) if @p b64 is not a valid encoding
+    static size_t encode(const void* data, size_t size, std::string& out) {
+        return impl::rt::Runtime<Alphabet, Padding>::encode(data, size, out);
+    }
+    static size_t decode(const char* b64, size_t size, std::string& out, size_t* error = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode(b64, size, out, error);
+    }
+
+#ifdef CT_BASE64_IOV
+    // gathering encoder: the @p count fragments of @p iov are encoded as one message, without a copy,
+    // the groups split between fragments are carried over (see Encoder)
+    // @p out must have room for encoded_size(iov, count) chars; returns the number of chars written
+    static size_t encode_iov(const iovec* iov, int count, char* out) {
+        return impl::rt::Runtime<Alphabet, Padding>::encode_iov(iov, count, out);
+    }
+    // chars written by encode_iov
+    static size_t encoded_size(const iovec* iov, int count) {
+        size_t size = 0;
+        for (int i = 0; i < count; ++i)
+            size += iov[i].iov_len;
+        return encoded_size(size);
+    }
+#endif
+
+    // multi-threaded versions for large buffers, same output and errors as the ones above; the input is
+    // cut into equal runs of whole groups, each one written straight to its offset in @p out
+    static size_t encode(const void* data, size_t size, char* out, const Parallel& parallel) {
+        return impl::rt::Runtime<Alphabet, Padding>::encode(data, size, out, parallel);
+    }
+    static size_t decode(const char* b64, size_t size, void* out, size_t* error, const Parallel& parallel) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode(b64, size, out, error, parallel);
+    }
+    static size_t decode_relaxed(const char* b64, size_t size, void* out, size_t* error, const Parallel& parallel) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode_relaxed(b64, size, out, error, parallel);
+    }
+
+    // batched runtime codec, for many small messages: the outputs go back to back into @p arena, the
+    // one of message i at [offsets[i], offsets[i + 1]) (@p offsets has count + 1 entries); the messages
+    // are staged so that every kernel call covers many of them
+    // @p arena must have room for encode_batch_size(in, count) chars; returns the number of chars written
+    static size_t encode_batch(const Slice* in, size_t count, char* arena, size_t* offsets) {
+        return impl::rt::Runtime<Alphabet, Padding>::encode_batch(in, count, arena, offsets);
+    }
+    // every message takes 4 * ceil(n / 3) chars while staged, even without padding
+    static size_t encode_batch_size(const Slice* in, size_t count) {
+        size_t size = 0;
+        for (size_t m = 0; m < count; ++m)
+            size += impl::encoded_length(6, in[m].size, true);
+        return size;
+    }
+    // @p arena must have room for decode_batch_size(in, count) bytes; returns the number of messages
+    // that are not valid encodings: their output is empty and errors[i] gets the offset of their first
+    // bad char (npos for the valid ones), if @p errors is given
+    static size_t decode_batch(const Slice* in, size_t count, void* arena, size_t* offsets, size_t* errors = nullptr) {
+        return impl::rt::Runtime<Alphabet, Padding>::decode_batch(in, count, arena, offsets, errors);
+    }
+    static size_t decode_batch_size(const Slice* in, size_t count) {
+        size_t size = 0;
+        for (size_t m = 0; m < count; ++m)
+            size += decoded_max_size(in[m].size);
+        return size;
+    }
+
+    // incremental runtime codec, for messages that arrive in chunks of any size
+    class Encoder;
+    class Decoder;
+
+    // runtime kernel tier picked at startup: "table" (portable), "sse4.1", "avx2" or "avx512vbmi"
+    // the environment variable CT_BASE64_TIER may force any tier the host supports, "scalar" included
+    static const char* tier() { return impl::rt::Runtime<Alphabet, Padding>::tier(); }
+    // checks every tier the host supports against the compile-time results
+    static bool self_test() { return impl::rt::Runtime<Alphabet, Padding>::self_test(); }
 };
 
-#include "ct-base64-impl.h"
+typedef BasicBase64<alphabet::Legacy>   Base64;
+typedef BasicBase64<alphabet::Standard> Base64Std;
+typedef BasicBase64<alphabet::UrlSafe>  Base64Url;
 
+template <class A, bool P>
 template <char... str>
-constexpr auto Base64::encode(ct::string<str...> s) {
-    return impl::CTBase64Encoder<str...>::encoded_string;
+constexpr auto BasicBase64<A, P>::encode(ct::string<str...> s) {
+    return impl::CTEncoder<A, P, str...>::encoded_string;
+}
+
+template <class A, bool P>
+template <size_t cols, bool crlf, char... str>
+constexpr auto BasicBase64<A, P>::encode_lines(ct::string<str...> s) {
+    static_assert(cols % 4 == 0, "BasicBase64::encode_lines: cols must be a multiple of 4");
+    return impl::CTEncoder<A, P, str...>::template lines<cols, crlf>();
+}
+
+template <class A, bool P>
+template <b64char... str>
+constexpr auto BasicBase64<A, P>::decode(ct::string<str...> s) {
+    return impl::CTDecoder<A, P, true, str...>::decoded_string;
+}
+
+template <class A, bool P>
+template <b64char... str>
+constexpr auto BasicBase64<A, P>::decode_relaxed(ct::string<str...> s) {
+    static_assert(impl::checks::is_encoding_relaxed_v<A, P, str...>, "Input string is not a valid base 64 encoding");
+    constexpr unsigned length = unsigned(impl::decoded_length(impl::tables_of<A>::value, impl::count_non_space<str...>()));
+    return ct::toolbox::lift_array<impl::char_array<length>, impl::decode_chars_relaxed<A, str...> >(
+        std::make_integer_sequence<unsigned, length>());
 }
 
+template <class A, bool P>
 template <b64char... str>
-constexpr auto Base64::decode(ct::string<str...> s) {
-    return impl::CTBase64Decoder<str...>::decoded_string;
+constexpr auto BasicBase64<A, P>::decode_bytes(ct::string<str...> s) {
+    static_assert(impl::checks::is_encoding_v<A, P, str...>, "Input string is not a valid base 64 encoding");
+    return impl::decode_bytes<A, str...>(std::make_index_sequence<impl::decoded_size<A, str...>()>());
 }
 
 }
@@ -0,0 +1,202 @@
+#ifdef CT_BASE_85_HPP
+
+namespace impl
+{
+namespace base85
+{
+    // dict and decode LUT of a base-85 alphabet policy, built at compile time
+    struct Tables : impl::SymbolIndex {
+        // the 85 digits, zero-filled to 128 entries for the SIMD lookups
+        int8_t dict[128];
+        // out of the decode LUT, as any char that is not a digit
+        b64char zero;
+        // 85 distinct ASCII symbols, and a zero group char out of them
+        bool valid;
+
+        constexpr Tables(const b64char* symbols, b64char zero) : dict(), zero(zero), valid(true) {
+            int n = 0;
+            for (; valid && symbols[n] != '\0'; ++n) {
+                const uint8_t s = uint8_t(symbols[n]);
+                if (n == 85 || index[s] >= 0 || s >= 0x80)
+                    valid = false;
+                else {
+                    dict[n] = int8_t(s);
+                    index[s] = int8_t(n);
+                }
+            }
+            if (n != 85 || uint8_t(zero) >= 0x80 || index[uint8_t(zero)] >= 0)
+                valid = false;
+        }
+    };
+
+    template<class Alphabet>
+    struct tables_of {
+        static constexpr Tables value{Alphabet::symbols(), Alphabet::zero_group()};
+    };
+
+    template<class Alphabet>
+    constexpr Tables tables_of<Alphabet>::value;
+
+    // the chars of a group: whole ones take 5, a short last one of n bytes n + 1
+    constexpr size_t encoded_length(size_t n) {
+        return n / 4 * 5 + (n % 4 ? n % 4 + 1 : 0);
+    }
+
+    // value of the digits of [in, in+n), a short group completed with the largest digit;
+    // over 0xFFFFFFFF when it does not fit in 4 bytes
+    constexpr uint64_t group_value(const Tables& t, const b64char* in, size_t n) {
+        uint64_t v = 0;
+        for (size_t j = 0; j < 5; ++j)
+            v = v * 85 + uint64_t(j < n ? t.index[uint8_t(in[j])] : 84);
+        return v;
+    }
+
+    namespace checks {
+        // every group of digits, up to a last one of 2 to 4, must fit in 4 bytes; the zero group char
+        // may only stand in place of a whole group
+        template<class A>
+        constexpr bool is_encoding(const b64char* chars, size_t n) {
+            const Tables t = tables_of<A>::value;
+            for (size_t i = 0; i < n;) {
+                if (t.zero && chars[i] == t.zero) {
+                    ++i;
+                    continue;
+                }
+                const size_t size = n - i < 5 ? n - i : 5;
+                if (size == 1)
+                    return false;
+                for (size_t j = i; j < i + size; ++j) {
+                    if (t.index[uint8_t(chars[j])] < 0)
+                        return false;
+                }
+                if (group_value(t, chars + i, size) > 0xFFFFFFFFu)
+                    return false;
+                i += size;
+            }
+            return true;
+        }
+
+        template<class A, char... chars>
+        constexpr bool is_encoding_pack() {
+            const b64char in[] = {chars..., '\0'};
+            return is_encoding<A>(in, sizeof...(chars));
+        }
+
+        template<class A, char... chars>
+        constexpr auto is_encoding_v = std::integral_constant<bool, is_encoding_pack<A, chars...>()>::value;
+    }
+
+    //////////// Encoder Impl. ////////////
+
+    // encoded_length less the 4 chars saved by each zero group
+    template<class A, char... chars>
+    constexpr size_t encoded_size() {
+        const b64char in[] = {chars..., '\0'};
+        const size_t n = sizeof...(chars);
+        size_t size = encoded_length(n);
+        for (size_t i = 0; tables_of<A>::value.zero && i + 4 <= n; i += 4) {
+            if ((in[i] | in[i + 1] | in[i + 2] | in[i + 3]) == 0)
+                size -= 4;
+        }
+        return size;
+    }
+
+    template<class A, char... chars>
+    constexpr char_array<encoded_size<A, chars...>()> encode_chars() {
+        const Tables t = tables_of<A>::value;
+        const b64char in[] = {chars..., '\0'};
+        const size_t n = sizeof...(chars);
+        char_array<encoded_size<A, chars...>()> out{};
+        size_t j = 0;
+        for (size_t i = 0; i < n; i += 4) {
+            uint32_t v = 0;
+            for (size_t k = i; k < i + 4; ++k)
+                v = v << 8 | (k < n ? uint8_t(in[k]) : 0);
+            if (t.zero && v == 0 && i + 4 <= n) {
+                out.data[j++] = t.zero;
+                continue;
+            }
+            b64char digits[5] = {};
+            for (size_t k = 5; k-- > 0; v /= 85)
+                digits[k] = b64char(t.dict[v % 85]);
+            for (size_t k = 0; k < 5 && k <= n - i; ++k)
+                out.data[j++] = digits[k];
+        }
+        return out;
+    }
+
+    template<class A, char... chars>
+    struct CTBase85Encoder {
+        static constexpr unsigned length = unsigned(encoded_size<A, chars...>());
+
+        static constexpr auto encoded_string = ct::toolbox::lift_array<char_array<length>, encode_chars<A, chars...> >(
+            std::make_integer_sequence<unsigned, length>());
+    };
+
+    //////////// Decoder Impl. ////////////
+
+    // 4 bytes per whole group or zero group char, n - 1 for a short last group of n chars
+    template<class A, b64char... chars>
+    constexpr size_t decoded_size() {
+        const b64char in[] = {chars..., '\0'};
+        const size_t n = sizeof...(chars);
+        size_t size = 0;
+        for (size_t i = 0; i < n;) {
+            const size_t step = (tables_of<A>::value.zero && in[i] == tables_of<A>::value.zero) ? 1
+                              : n - i < 5 ? n - i : 5;
+            size += step == 1 ? 4 : step - 1;
+            i += step;
+        }
+        return size;
+    }
+
+    template<class A, b64char... chars>
+    constexpr char_array<decoded_size<A, chars...>()> decode_chars() {
+        const Tables t = tables_of<A>::value;
+        const b64char in[] = {chars..., '\0'};
+        const size_t n = sizeof...(chars);
+        char_array<decoded_size<A, chars...>()> out{};
+        size_t j = 0;
+        for (size_t i = 0; i < n;) {
+            if (t.zero && in[i] == t.zero) {
+                j += 4;
+                ++i;
+                continue;
+            }
+            const size_t size = n - i < 5 ? n - i : 5;
+            const uint64_t v = group_value(t, in + i, size);
+            for (size_t k = 0; k + 1 < size; ++k)
+                out.data[j++] = b64char((v >> (24 - 8 * k)) & 0xFF);
+            i += size;
+        }
+        return out;
+    }
+
+    // the decoded chars lifted into a ct::bytes, as in ct::toolbox::lift_array
+    template<class A, b64char... chars, size_t... I>
+    constexpr auto decode_bytes(std::index_sequence<I...>) {
+        constexpr char_array<decoded_size<A, chars...>()> a = decode_chars<A, chars...>();
+        static_cast<void>(a);
+        return ct::bytes<uint8_t(a.data[I])...>();
+    }
+
+    template<bool isvalid, class A, b64char... chars>
+    struct b85_decode_if {
+        static_assert(isvalid, "Input string is not a valid base 85 encoding");
+        static constexpr auto decoded_string = ct::string<>();
+    };
+
+    template<class A, b64char... chars>
+    struct b85_decode_if<true, A, chars...> {
+        static constexpr unsigned length = unsigned(decoded_size<A, chars...>());
+
+        static constexpr auto decoded_string = ct::toolbox::lift_array<char_array<length>, decode_chars<A, chars...> >(
+            std::make_integer_sequence<unsigned, length>());
+    };
+
+    template<class A, b64char... chars>
+    struct CTBase85Decoder : b85_decode_if<checks::is_encoding_v<A, chars...>, A, chars...> { };
+}
+}
+
+#endif // CT_BASE_85_HPP
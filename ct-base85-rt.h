@@ -0,0 +1,381 @@
+#ifdef CT_BASE_85_HPP
+
+namespace impl
+{
+namespace base85
+{
+namespace rt
+{
+    using impl::rt::Tier;
+    using impl::rt::npos;
+    using impl::rt::decode_error;
+    using impl::rt::find_invalid;
+
+    //////////// Scalar Encoder ////////////
+
+    // one 4-byte group per iteration; encodes the whole groups of [in, in+n) and returns the number
+    // of chars written
+    inline size_t encode_scalar(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        char* dst = out;
+        for (; n >= 4; n -= 4, in += 4) {
+            uint32_t v = uint32_t(in[0]) << 24 | uint32_t(in[1]) << 16 | uint32_t(in[2]) << 8 | in[3];
+            if (t.zero && v == 0) {
+                *dst++ = t.zero;
+                continue;
+            }
+            for (size_t k = 5; k-- > 0; v /= 85)
+                dst[k] = char(t.dict[v % 85]);
+            dst += 5;
+        }
+        return size_t(dst - out);
+    }
+
+    // last group of 1 to 3 bytes
+    inline size_t encode_tail(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        if (n == 0)
+            return 0;
+        uint32_t v = 0;
+        for (size_t k = 0; k < 4; ++k)
+            v = v << 8 | (k < n ? in[k] : 0);
+        char digits[5];
+        for (size_t k = 5; k-- > 0; v /= 85)
+            digits[k] = char(t.dict[v % 85]);
+        std::memcpy(out, digits, n + 1);
+        return n + 1;
+    }
+
+    //////////// Scalar Decoder ////////////
+
+    // decodes whole 5-char groups (no zero group char) and stops before the first group holding a char
+    // that is not a digit, or over 0xFFFFFFFF; returns the number of chars consumed
+    inline size_t decode_scalar(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const int8_t* index = t.index;
+        size_t i = 0;
+        for (; i + 5 <= n; i += 5, out += 4) {
+            uint64_t v = 0;
+            int32_t bad = 0;
+            for (size_t k = 0; k < 5; ++k) {
+                const int32_t d = index[uint8_t(in[i + k])];
+                bad |= d;
+                v = v * 85 + uint8_t(d);
+            }
+            if (bad < 0 || v > 0xFFFFFFFFu)
+                break;
+            out[0] = uint8_t(v >> 24);
+            out[1] = uint8_t(v >> 16);
+            out[2] = uint8_t(v >> 8);
+            out[3] = uint8_t(v);
+        }
+        return i;
+    }
+
+#ifdef CT_BASE64_X86
+    using impl::rt::Lut128;
+    using impl::rt::lut128_sse41;
+    using impl::rt::lookup128_sse41;
+    using impl::rt::Lut256;
+    using impl::rt::lut128_avx2;
+    using impl::rt::lookup128_avx2;
+
+    // ceil(2^44 / 7225): x / 85^2 == (x * 0x9121B243) >> 44 for every 32-bit x
+    static constexpr uint32_t div7225_magic = 0x9121B243u;
+    // ceil(2^20 / 85): x / 85 == (x * 12337) >> 20 for every x below 85^2
+    static constexpr int16_t div85_magic = 12337;
+
+    // largest value of the first 4 digits of a group that fits in 4 bytes (85 divides 2^32 - 1)
+    static constexpr int32_t max_high4 = int32_t(0xFFFFFFFFu / 85);
+
+    //////////// SSE4.1 Kernels ////////////
+
+    // x / 85^2 in each 32-bit lane, from the 64-bit products of the even and the odd lanes
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i div7225_sse41(__m128i x) {
+        const __m128i magic = _mm_set1_epi32(int(div7225_magic));
+        const __m128i even = _mm_srli_epi64(_mm_mul_epu32(x, magic), 44);
+        const __m128i odd = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(x, 32), magic), 44);
+        return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xCC);
+    }
+
+    // the 5 digits of each 32-bit lane, x = (d0 * 85^2 + d12) * 85^2 + d34: d0 in @p lead, d1-d4 as the
+    // bytes of @p rest, the pairs d12 and d34 split in 16-bit lanes
+    CT_BASE64_TARGET("sse4.1")
+    inline void digits_sse41(__m128i x, __m128i& lead, __m128i& rest) {
+        const __m128i n7225 = _mm_set1_epi32(7225);
+        const __m128i q = div7225_sse41(x);
+        lead = div7225_sse41(q);
+        const __m128i pairs = _mm_or_si128(_mm_sub_epi32(q, _mm_mullo_epi32(lead, n7225)),
+                                           _mm_slli_epi32(_mm_sub_epi32(x, _mm_mullo_epi32(q, n7225)), 16));
+        const __m128i hi = _mm_srli_epi16(_mm_mulhi_epu16(pairs, _mm_set1_epi16(div85_magic)), 4);
+        const __m128i lo = _mm_sub_epi16(pairs, _mm_mullo_epi16(hi, _mm_set1_epi16(85)));
+        rest = _mm_or_si128(hi, _mm_slli_epi16(lo, 8));
+    }
+
+    // the 4 digits held in the bytes of @p digits, as chars; cheaper than a vector lookup for so few
+    inline void put_digits(char* dst, uint32_t digits, const Tables& t) {
+        dst[0] = char(t.dict[digits & 0xFF]);
+        dst[1] = char(t.dict[digits >> 8 & 0xFF]);
+        dst[2] = char(t.dict[digits >> 16 & 0xFF]);
+        dst[3] = char(t.dict[digits >> 24]);
+    }
+
+    // 16 input bytes -> 20 output chars per iteration; the blocks holding a zero group are left to
+    // the scalar encoder when the alphabet shortens them
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t encode_sse41(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const Lut128 dict = lut128_sse41(t.dict);
+        const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        // chars 0-15 and the digits of chars 16-19 of the 4 groups, from the leading digits and from the other ones
+        const __m128i first_lead = _mm_setr_epi8(0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1, -1, -1, -1, 12);
+        const __m128i first_rest = _mm_setr_epi8(-1, 0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1);
+        const __m128i last_rest = _mm_setr_epi8(12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        char* dst = out;
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), bswap);
+            if (t.zero && _mm_movemask_epi8(_mm_cmpeq_epi32(x, _mm_setzero_si128()))) {
+                dst += encode_scalar(in + i, 16, dst, t);
+                continue;
+            }
+            __m128i lead, rest;
+            digits_sse41(x, lead, rest);
+            const __m128i first = _mm_or_si128(_mm_shuffle_epi8(lead, first_lead), _mm_shuffle_epi8(rest, first_rest));
+            const __m128i last = _mm_shuffle_epi8(rest, last_rest);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), lookup128_sse41(first, dict));
+            put_digits(dst + 16, uint32_t(_mm_cvtsi128_si32(last)), t);
+            dst += 20;
+        }
+        return size_t(dst - out) + encode_scalar(in + i, n - i, dst, t);
+    }
+
+    // the bytes of 3 groups: digits 0-3 of each one through maddubs (d0 * 85 + d1) and madd
+    // (d01 * 85^2 + d23), then times 85 plus digit 4; @p overflow flags the groups over 0xFFFFFFFF
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i group_values_sse41(__m128i digits, __m128i& overflow) {
+        const __m128i high4 = _mm_setr_epi8(0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, -1, -1, -1, -1);
+        const __m128i last = _mm_setr_epi8(4, -1, -1, -1, 9, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i h = _mm_madd_epi16(_mm_maddubs_epi16(_mm_shuffle_epi8(digits, high4), _mm_set1_epi16(0x0155)),
+                                         _mm_set1_epi32(0x00011C39));
+        const __m128i l = _mm_shuffle_epi8(digits, last);
+        const __m128i max = _mm_set1_epi32(max_high4);
+        overflow = _mm_or_si128(_mm_cmpgt_epi32(h, max),
+                                _mm_and_si128(_mm_cmpeq_epi32(h, max), _mm_cmpgt_epi32(l, _mm_setzero_si128())));
+        return _mm_add_epi32(_mm_mullo_epi32(h, _mm_set1_epi32(85)), l);
+    }
+
+    // 15 input chars -> 12 output bytes per iteration (reads and writes 16 bytes)
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t decode_sse41(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const Lut128 index = lut128_sse41(t.index);
+        const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, -1, -1, -1, -1);
+        size_t i = 0;
+        for (; i + 20 <= n; i += 15) {
+            const __m128i digits = lookup128_sse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), index);
+            __m128i overflow;
+            const __m128i x = group_values_sse41(digits, overflow);
+            if ((_mm_movemask_epi8(digits) & 0x7FFF) | (_mm_movemask_epi8(overflow) & 0x0FFF))
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 5 * 4), _mm_shuffle_epi8(x, bswap));
+        }
+        return i + decode_scalar(in + i, n - i, out + i / 5 * 4, t);
+    }
+
+    //////////// AVX2 Kernels ////////////
+
+    // see div7225_sse41
+    CT_BASE64_TARGET("avx2")
+    inline __m256i div7225_avx2(__m256i x) {
+        const __m256i magic = _mm256_set1_epi32(int(div7225_magic));
+        const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, magic), 44);
+        const __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), magic), 44);
+        return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    }
+
+    // see digits_sse41
+    CT_BASE64_TARGET("avx2")
+    inline void digits_avx2(__m256i x, __m256i& lead, __m256i& rest) {
+        const __m256i n7225 = _mm256_set1_epi32(7225);
+        const __m256i q = div7225_avx2(x);
+        lead = div7225_avx2(q);
+        const __m256i pairs = _mm256_or_si256(_mm256_sub_epi32(q, _mm256_mullo_epi32(lead, n7225)),
+                                              _mm256_slli_epi32(_mm256_sub_epi32(x, _mm256_mullo_epi32(q, n7225)), 16));
+        const __m256i hi = _mm256_srli_epi16(_mm256_mulhi_epu16(pairs, _mm256_set1_epi16(div85_magic)), 4);
+        const __m256i lo = _mm256_sub_epi16(pairs, _mm256_mullo_epi16(hi, _mm256_set1_epi16(85)));
+        rest = _mm256_or_si256(hi, _mm256_slli_epi16(lo, 8));
+    }
+
+    // 32 input bytes -> 40 output chars per iteration; see encode_sse41
+    CT_BASE64_TARGET("avx2")
+    inline size_t encode_avx2(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const Lut256 dict = lut128_avx2(t.dict);
+        const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        const __m256i first_lead = _mm256_setr_epi8(0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1, -1, -1, -1, 12,
+                                                    0, -1, -1, -1, -1, 4, -1, -1, -1, -1, 8, -1, -1, -1, -1, 12);
+        const __m256i first_rest = _mm256_setr_epi8(-1, 0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1,
+                                                    -1, 0, 1, 2, 3, -1, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1);
+        const __m256i last_rest = _mm256_setr_epi8(12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                   12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        char* dst = out;
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256i x = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), bswap);
+            if (t.zero && _mm256_movemask_epi8(_mm256_cmpeq_epi32(x, _mm256_setzero_si256()))) {
+                dst += encode_scalar(in + i, 32, dst, t);
+                continue;
+            }
+            __m256i lead, rest;
+            digits_avx2(x, lead, rest);
+            const __m256i first = lookup128_avx2(_mm256_or_si256(_mm256_shuffle_epi8(lead, first_lead),
+                                                                 _mm256_shuffle_epi8(rest, first_rest)), dict);
+            const __m256i last = _mm256_shuffle_epi8(rest, last_rest);
+            // 20 chars per lane
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(first));
+            put_digits(dst + 16, uint32_t(_mm256_extract_epi32(last, 0)), t);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 20), _mm256_extracti128_si256(first, 1));
+            put_digits(dst + 36, uint32_t(_mm256_extract_epi32(last, 4)), t);
+            dst += 40;
+        }
+        return size_t(dst - out) + encode_sse41(in + i, n - i, dst, t);
+    }
+
+    // 30 input chars -> 24 output bytes per iteration (reads 31 bytes, writes 32); see decode_sse41
+    CT_BASE64_TARGET("avx2")
+    inline size_t decode_avx2(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const Lut256 index = lut128_avx2(t.index);
+        const __m256i high4 = _mm256_setr_epi8(0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, -1, -1, -1, -1,
+                                               0, 1, 2, 3, 5, 6, 7, 8, 10, 11, 12, 13, -1, -1, -1, -1);
+        const __m256i last = _mm256_setr_epi8(4, -1, -1, -1, 9, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1,
+                                              4, -1, -1, -1, 9, -1, -1, -1, 14, -1, -1, -1, -1, -1, -1, -1);
+        const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, -1, -1, -1, -1,
+                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, -1, -1, -1, -1);
+        const __m256i max = _mm256_set1_epi32(max_high4);
+        const __m256i pack = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+        size_t i = 0;
+        for (; i + 40 <= n; i += 30) {
+            const __m256i digits = lookup128_avx2(impl::rt::load_lanes_avx2(in + i, in + i + 15), index);
+            const __m256i h = _mm256_madd_epi16(_mm256_maddubs_epi16(_mm256_shuffle_epi8(digits, high4),
+                                                                     _mm256_set1_epi16(0x0155)),
+                                                _mm256_set1_epi32(0x00011C39));
+            const __m256i l = _mm256_shuffle_epi8(digits, last);
+            const __m256i overflow = _mm256_or_si256(_mm256_cmpgt_epi32(h, max),
+                _mm256_and_si256(_mm256_cmpeq_epi32(h, max), _mm256_cmpgt_epi32(l, _mm256_setzero_si256())));
+            if ((_mm256_movemask_epi8(digits) & 0x7FFF7FFF) | (_mm256_movemask_epi8(overflow) & 0x0FFF0FFF))
+                break;
+            const __m256i x = _mm256_add_epi32(_mm256_mullo_epi32(h, _mm256_set1_epi32(85)), l);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 5 * 4),
+                                _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(x, bswap), pack));
+        }
+        return i + decode_sse41(in + i, n - i, out + i / 5 * 4, t);
+    }
+#endif // CT_BASE64_X86
+
+    //////////// Dispatch ////////////
+
+    struct Kernels {
+        Tier tier;
+        // whole groups only, see encode_scalar and decode_scalar
+        size_t (*encode)(const uint8_t* in, size_t n, char* out, const Tables& t);
+        size_t (*decode)(const char* in, size_t n, uint8_t* out, const Tables& t);
+    };
+
+    // AVX-512 VBMI adds nothing over AVX2 here
+    inline Kernels kernels_for(Tier tier) {
+#ifdef CT_BASE64_X86
+        if (tier >= Tier::avx2)
+            return { Tier::avx2, encode_avx2, decode_avx2 };
+        if (tier >= Tier::sse41)
+            return { Tier::sse41, encode_sse41, decode_sse41 };
+#endif
+        return { Tier::scalar, encode_scalar, decode_scalar };
+    }
+
+    // same tier as the Base64 kernels
+    inline const Kernels& kernels() {
+        static const Kernels selected = base85::rt::kernels_for(impl::rt::select_tier());
+        return selected;
+    }
+
+    //////////// Drivers ////////////
+
+    inline size_t encode(const Kernels& k, const Tables& t, const uint8_t* in, size_t n, char* out) {
+        const size_t whole = n & ~size_t(3);
+        const size_t written = k.encode(in, whole, out, t);
+        return written + encode_tail(in + whole, n - whole, out + written, t);
+    }
+
+    // same acceptance rules as checks::is_encoding_v; the kernels stop at each zero group char, which
+    // shifts the groups behind it by one char
+    inline size_t decode(const Kernels& k, const Tables& t, const char* in, size_t n, uint8_t* out, size_t* error) {
+        size_t i = 0;
+        uint8_t* dst = out;
+        for (;;) {
+            const size_t whole = (n - i) - (n - i) % 5;
+            const size_t used = k.decode(in + i, whole, dst, t);
+            i += used;
+            dst += used / 5 * 4;
+            if (i == n)
+                return size_t(dst - out);
+            if (t.zero && in[i] == t.zero) {
+                std::memset(dst, 0, 4);
+                dst += 4;
+                ++i;
+                continue;
+            }
+            // a bad group, or the last one
+            const size_t size = n - i < 5 ? n - i : 5;
+            const size_t bad = find_invalid(in + i, size, t);
+            if (bad < size)
+                return decode_error(error, i + bad);
+            if (size == 1 || group_value(t, in + i, size) > 0xFFFFFFFFu)
+                return decode_error(error, i);
+            const uint32_t v = uint32_t(group_value(t, in + i, size));
+            for (size_t j = 0; j + 1 < size; ++j)
+                *dst++ = uint8_t(v >> (24 - 8 * j));
+            return size_t(dst - out);
+        }
+    }
+
+    //////////// Self-test ////////////
+
+    // impl::rt::run_self_test for BasicBase85<A>, the payloads sprinkled with zero groups
+    template<class A>
+    struct Base85SelfTest : impl::rt::SelfTestHooks {
+        // out of both alphabets
+        static constexpr char bad_char = '~';
+
+        static const Tables& tables() { return tables_of<A>::value; }
+        static uint8_t byte(uint32_t seed) { return (seed >> 24) < 32 ? 0 : uint8_t(seed); }
+
+        Kernels kernels(Tier tier) const { return base85::rt::kernels_for(tier); }
+        size_t encode(const Kernels& k, const uint8_t* in, size_t n, char* out) const {
+            return rt::encode(k, tables(), in, n, out);
+        }
+        size_t decode(const Kernels& k, const char* in, size_t n, uint8_t* out, size_t* error) const {
+            return rt::decode(k, tables(), in, n, out, error);
+        }
+        size_t corruptible(const char*, size_t n) const { return n; }
+    };
+
+    template<class A>
+    inline bool self_test() {
+#define CT_BASE85_VECTOR(s) { s, sizeof(s) - 1, BasicBase85<A>::encode(CTSTRING(s)).data }
+        const impl::rt::TestVector vectors[] = {
+            CT_BASE85_VECTOR(""),
+            CT_BASE85_VECTOR("f"),
+            CT_BASE85_VECTOR("fo"),
+            CT_BASE85_VECTOR("foo"),
+            CT_BASE85_VECTOR("foob"),
+            CT_BASE85_VECTOR("fooba"),
+            CT_BASE85_VECTOR("\x86\x4F\xD2\x6F\xB5\x59\xF7\x5B"),
+            CT_BASE85_VECTOR("\xff\xff\xff\xff\x00\x00\x00\x00\xff\xff\xff"),
+            CT_BASE85_VECTOR("The quick brown fox jumps over the lazy dog, then the lazy dog wakes up and "
+                             "chases the quick brown fox \xfb\xff\xbf\xfe all the way back over the hill."),
+        };
+#undef CT_BASE85_VECTOR
+        return impl::rt::run_self_test(Base85SelfTest<A>(), vectors);
+    }
+}
+}
+}
+
+#endif // CT_BASE_85_HPP
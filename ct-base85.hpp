@@ -0,0 +1,151 @@
+/**
+ * Compile-time lib
+ * @file    ct-base85.hpp
+ * @brief   A compile-time Z85/Ascii85 encoder/decoder (with a SIMD runtime codec)
+ * @author  Douglas Oliveira
+ * @date    2026-10-16
+ *
+ * 4 bytes, read as a big-endian 32-bit number, are written as 5 base-85 digits, most significant first.
+ * A short last group of 1-3 bytes is zero-filled and cut to its first n + 1 digits; on decoding, the
+ * missing digits are taken as the largest one (the Ascii85 rule, which Z85 proper leaves out: it only
+ * encodes multiples of 4 bytes). Ascii85 also writes a group of 4 zero bytes as a single 'z'; its
+ * <~ ~> delimiters and whitespace are left to the caller.
+ *
+ * @note !!C++14 dependent module!!
+ */
+
+#ifndef CT_BASE_85_HPP
+#define CT_BASE_85_HPP
+
+#include "ct-radix.hpp"
+
+namespace ct
+{
+
+// base-85 alphabet policies: symbols() returns the 85 digits in order, zero_group() the char that stands
+// for 4 zero bytes ('\0' for none)
+namespace alphabet
+{
+    // ZeroMQ RFC 32, safe in source code strings and XML
+    struct Z85 {
+        static constexpr const b64char* symbols() {
+            return "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ.-:+=^!/*?&<>()[]{}@%$#";
+        }
+        static constexpr b64char zero_group() { return '\0'; }
+    };
+    // btoa and Adobe Ascii85, '!' to 'u'
+    struct Ascii85 {
+        static constexpr const b64char* symbols() {
+            return "!\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstu";
+        }
+        static constexpr b64char zero_group() { return 'z'; }
+    };
+}
+
+#include "ct-base85-impl.h"
+
+template <class Alphabet>
+struct BasicBase85 {
+    static_assert(impl::base85::tables_of<Alphabet>::value.valid,
+                  "BasicBase85: the alphabet needs 85 distinct ASCII symbols, and a zero group char out of them");
+
+    typedef Alphabet alphabet_type;
+
+    // return a compile-time string
+    template <char... str>
+    static constexpr auto encode(ct::string<str...> s);
+    // return a compile-time string holding the exact payload
+    template <char... str>
+    static constexpr auto decode(ct::string<str...> s);
+    // return a compile-time byte string holding the exact payload
+    template <char... str>
+    static constexpr auto decode_bytes(ct::string<str...> s);
+
+    static constexpr size_t npos = size_t(-1);
+
+    // chars the runtime encoder may write for @p size bytes (exact unless zero groups are shortened)
+    static constexpr size_t encoded_size(size_t size) { return impl::base85::encoded_length(size); }
+    // bytes the runtime decoder may write for @p size chars (exact unless zero groups are shortened)
+    static constexpr size_t decoded_max_size(size_t size) {
+        return impl::base85::tables_of<Alphabet>::value.zero ? size * 4 : size / 5 * 4 + (size % 5 ? size % 5 - 1 : 0);
+    }
+
+    // runtime encoder, same output as the compile-time one
+    // @p out must have room for encoded_size(size) chars; returns the number of chars written
+    static size_t encode(const void* data, size_t size, char* out);
+    // runtime decoder, accepts the same inputs as the compile-time one
+    // @p out must have room for decoded_max_size(size) bytes; returns the number of bytes written, or npos
+    // if @p text is not a valid encoding (a bad char, a group over 2^32 - 1 or a last group of a single
+    // char), in which case the offset of the bad char, or else of the group, is stored in @p error
+    static size_t decode(const char* text, size_t size, void* out, size_t* error = nullptr);
+
+    // append to @p out, grown once to the final size; return the number of chars or bytes appended,
+    // or npos (@p out left as it was) if @p text is not a valid encoding
+    static size_t encode(const void* data, size_t size, std::string& out);
+    static size_t decode(const char* text, size_t size, std::string& out, size_t* error = nullptr);
+
+    // runtime kernel tier picked at startup: "scalar", "sse4.1" or "avx2"
+    static const char* tier();
+    // checks every tier the host supports against the compile-time results
+    static bool self_test();
+};
+
+typedef BasicBase85<alphabet::Z85>     Z85;
+typedef BasicBase85<alphabet::Ascii85> Ascii85;
+
+template <class A>
+template <char... str>
+constexpr auto BasicBase85<A>::encode(ct::string<str...> s) {
+    return impl::base85::CTBase85Encoder<A, str...>::encoded_string;
+}
+
+template <class A>
+template <char... str>
+constexpr auto BasicBase85<A>::decode(ct::string<str...> s) {
+    return impl::base85::CTBase85Decoder<A, str...>::decoded_string;
+}
+
+template <class A>
+template <char... str>
+constexpr auto BasicBase85<A>::decode_bytes(ct::string<str...> s) {
+    static_assert(impl::base85::checks::is_encoding_v<A, str...>, "Input string is not a valid base 85 encoding");
+    return impl::base85::decode_bytes<A, str...>(std::make_index_sequence<impl::base85::decoded_size<A, str...>()>());
+}
+
+#include "ct-base85-rt.h"
+
+template <class A>
+inline size_t BasicBase85<A>::encode(const void* data, size_t size, char* out) {
+    const impl::base85::Tables& t = impl::base85::tables_of<A>::value;
+    return impl::base85::rt::encode(impl::base85::rt::kernels(), t, static_cast<const uint8_t*>(data), size, out);
+}
+
+template <class A>
+inline size_t BasicBase85<A>::decode(const char* text, size_t size, void* out, size_t* error) {
+    const impl::base85::Tables& t = impl::base85::tables_of<A>::value;
+    return impl::base85::rt::decode(impl::base85::rt::kernels(), t, text, size, static_cast<uint8_t*>(out), error);
+}
+
+template <class A>
+inline size_t BasicBase85<A>::encode(const void* data, size_t size, std::string& out) {
+    return impl::rt::append(out, encoded_size(size), [&](char* dst) { return encode(data, size, dst); });
+}
+
+template <class A>
+inline size_t BasicBase85<A>::decode(const char* text, size_t size, std::string& out, size_t* error) {
+    return impl::rt::append(out, decoded_max_size(size), [&](char* dst) { return decode(text, size, dst, error); });
+}
+
+template <class A>
+inline const char* BasicBase85<A>::tier() {
+    return impl::rt::tier_names[int(impl::base85::rt::kernels().tier)];
+}
+
+template <class A>
+inline bool BasicBase85<A>::self_test() {
+    return impl::base85::rt::self_test<A>();
+}
+
+}
+
+#endif // CT_BASE_85_HPP
@@ -0,0 +1,276 @@
+#ifdef CT_RADIX_HPP
+
+namespace impl
+{
+namespace rt
+{
+#ifdef CT_BASE64_X86
+    //////////// SSE4.1 Kernels ////////////
+
+    // a 128-entry byte table (the ASCII half of Tables::index, say), one row per high nibble
+    struct Lut128 {
+        __m128i row[8];
+    };
+
+    CT_BASE64_TARGET("sse4.1")
+    inline Lut128 lut128_sse41(const int8_t* table) {
+        Lut128 r;
+        for (int h = 0; h < 8; ++h)
+            r.row[h] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * h));
+        return r;
+    }
+
+    // table entry of 16 bytes, any table (the dict index of any alphabet and aliases, for one): a shuffle
+    // per row picks the entry of the low nibble, then a blend tree over bits 4, 5 and 6 the row; 0xFF
+    // for the bytes over 127 (the non-ASCII chars)
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i lookup128_sse41(__m128i c, const Lut128& r) {
+        // bits 4, 5 and 6 moved to bit 7, the one blendv looks at
+        const __m128i b4 = _mm_slli_epi16(c, 3), b5 = _mm_slli_epi16(c, 2), b6 = _mm_slli_epi16(c, 1);
+        const __m128i r01 = _mm_blendv_epi8(_mm_shuffle_epi8(r.row[0], c), _mm_shuffle_epi8(r.row[1], c), b4);
+        const __m128i r23 = _mm_blendv_epi8(_mm_shuffle_epi8(r.row[2], c), _mm_shuffle_epi8(r.row[3], c), b4);
+        const __m128i r45 = _mm_blendv_epi8(_mm_shuffle_epi8(r.row[4], c), _mm_shuffle_epi8(r.row[5], c), b4);
+        const __m128i r67 = _mm_blendv_epi8(_mm_shuffle_epi8(r.row[6], c), _mm_shuffle_epi8(r.row[7], c), b4);
+        const __m128i r03 = _mm_blendv_epi8(r01, r23, b5);
+        const __m128i r47 = _mm_blendv_epi8(r45, r67, b5);
+        return _mm_or_si128(_mm_blendv_epi8(r03, r47, b6), _mm_cmplt_epi8(c, _mm_setzero_si128()));
+    }
+
+    // maps 16 5-bit indices to dict characters, a shuffle per half of dict
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i lookup32_sse41(__m128i idx, __m128i dict_lo, __m128i dict_hi) {
+        return _mm_blendv_epi8(_mm_shuffle_epi8(dict_lo, idx), _mm_shuffle_epi8(dict_hi, idx),
+                               _mm_cmpgt_epi8(idx, _mm_set1_epi8(15)));
+    }
+
+    // 16 input bytes -> 32 output chars per iteration
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t encode16_sse41(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m128i dict = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.dict));
+        const __m128i low = _mm_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low);
+            const __m128i lo = _mm_and_si128(v, low);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i), _mm_shuffle_epi8(dict, _mm_unpacklo_epi8(hi, lo)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16), _mm_shuffle_epi8(dict, _mm_unpackhi_epi8(hi, lo)));
+        }
+        return 2 * i + encode_scalar<4>(in + i, n - i, out + 2 * i, t);
+    }
+
+    // 32 input chars -> 16 output bytes per iteration
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t decode16_sse41(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const Lut128 rows = lut128_sse41(t.index);
+        // hi * 16 + lo
+        const __m128i pairs = _mm_set1_epi16(0x0110);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m128i a = lookup128_sse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), rows);
+            const __m128i b = lookup128_sse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 16)), rows);
+            if (_mm_movemask_epi8(_mm_or_si128(a, b)))
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 2),
+                             _mm_packus_epi16(_mm_maddubs_epi16(a, pairs), _mm_maddubs_epi16(b, pairs)));
+        }
+        return i + decode_scalar<4>(in + i, n - i, out + i / 2, t);
+    }
+
+    // the 16-bit word holding each symbol of a 5-byte group (big-endian), then the right shift
+    // (a mulhi by 2^(16 - shift)) that brings the symbol down to bits 0-4
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i unpack32_sse41(__m128i v, __m128i shuf) {
+        const __m128i shift = _mm_setr_epi16(1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8);
+        return _mm_and_si128(_mm_mulhi_epu16(_mm_shuffle_epi8(v, shuf), shift), _mm_set1_epi16(0x1F));
+    }
+
+    // 10 input bytes -> 16 output chars per iteration (reads 16 bytes)
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t encode32_sse41(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m128i dict_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.dict));
+        const __m128i dict_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.dict + 16));
+        const __m128i shuf0 = _mm_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4);
+        const __m128i shuf1 = _mm_add_epi8(shuf0, _mm_set1_epi8(5));
+        size_t i = 0;
+        for (; i + 16 <= n; i += 10) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+            const __m128i idx = _mm_packus_epi16(unpack32_sse41(v, shuf0), unpack32_sse41(v, shuf1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 5 * 8), lookup32_sse41(idx, dict_lo, dict_hi));
+        }
+        return i / 5 * 8 + encode_scalar<5>(in + i, n - i, out + i / 5 * 8, t);
+    }
+
+    // merges the 5-bit indices of each 64-bit lane into a 40-bit group, then stores its bytes
+    // big-endian at the front of the lane
+    CT_BASE64_TARGET("sse4.1")
+    inline __m128i pack32_sse41(__m128i idx) {
+        // a * 32 + b, then ab * 1024 + cd
+        const __m128i w = _mm_maddubs_epi16(idx, _mm_set1_epi16(0x0120));
+        const __m128i d = _mm_madd_epi16(w, _mm_set1_epi32(0x00010400));
+        const __m128i s = _mm_or_si128(_mm_slli_epi64(d, 20), _mm_srli_epi64(d, 32));
+        return _mm_shuffle_epi8(s, _mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1));
+    }
+
+    // 16 input chars -> 10 output bytes per iteration (writes 16 bytes)
+    CT_BASE64_TARGET("sse4.1")
+    inline size_t decode32_sse41(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const Lut128 rows = lut128_sse41(t.index);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 16) {
+            const __m128i idx = lookup128_sse41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), rows);
+            if (_mm_movemask_epi8(idx))
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i / 8 * 5), pack32_sse41(idx));
+        }
+        return i + decode_scalar<5>(in + i, n - i, out + i / 8 * 5, t);
+    }
+
+    //////////// AVX2 Kernels ////////////
+
+    struct Lut256 {
+        __m256i row[8];
+    };
+
+    CT_BASE64_TARGET("avx2")
+    inline Lut256 lut128_avx2(const int8_t* table) {
+        Lut256 r;
+        for (int h = 0; h < 8; ++h)
+            r.row[h] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * h)));
+        return r;
+    }
+
+    // see lookup128_sse41
+    CT_BASE64_TARGET("avx2")
+    inline __m256i lookup128_avx2(__m256i c, const Lut256& r) {
+        const __m256i b4 = _mm256_slli_epi16(c, 3), b5 = _mm256_slli_epi16(c, 2), b6 = _mm256_slli_epi16(c, 1);
+        const __m256i r01 = _mm256_blendv_epi8(_mm256_shuffle_epi8(r.row[0], c), _mm256_shuffle_epi8(r.row[1], c), b4);
+        const __m256i r23 = _mm256_blendv_epi8(_mm256_shuffle_epi8(r.row[2], c), _mm256_shuffle_epi8(r.row[3], c), b4);
+        const __m256i r45 = _mm256_blendv_epi8(_mm256_shuffle_epi8(r.row[4], c), _mm256_shuffle_epi8(r.row[5], c), b4);
+        const __m256i r67 = _mm256_blendv_epi8(_mm256_shuffle_epi8(r.row[6], c), _mm256_shuffle_epi8(r.row[7], c), b4);
+        const __m256i r03 = _mm256_blendv_epi8(r01, r23, b5);
+        const __m256i r47 = _mm256_blendv_epi8(r45, r67, b5);
+        return _mm256_or_si256(_mm256_blendv_epi8(r03, r47, b6), _mm256_cmpgt_epi8(_mm256_setzero_si256(), c));
+    }
+
+    // loads 16 bytes at @p lo and @p hi into the two lanes
+    CT_BASE64_TARGET("avx2")
+    inline __m256i load_lanes_avx2(const void* lo, const void* hi) {
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128(static_cast<const __m128i*>(lo))),
+                                       _mm_loadu_si128(static_cast<const __m128i*>(hi)), 1);
+    }
+
+    // 32 input bytes -> 64 output chars per iteration
+    CT_BASE64_TARGET("avx2")
+    inline size_t encode16_avx2(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m256i dict = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.dict)));
+        const __m256i low = _mm256_set1_epi8(0x0F);
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low);
+            const __m256i lo = _mm256_and_si256(v, low);
+            // bytes 0-7 | 16-23 and 8-15 | 24-31
+            const __m256i a = _mm256_shuffle_epi8(dict, _mm256_unpacklo_epi8(hi, lo));
+            const __m256i b = _mm256_shuffle_epi8(dict, _mm256_unpackhi_epi8(hi, lo));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+        }
+        return 2 * i + encode16_sse41(in + i, n - i, out + 2 * i, t);
+    }
+
+    // 64 input chars -> 32 output bytes per iteration
+    CT_BASE64_TARGET("avx2")
+    inline size_t decode16_avx2(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const Lut256 rows = lut128_avx2(t.index);
+        const __m256i pairs = _mm256_set1_epi16(0x0110);
+        size_t i = 0;
+        for (; i + 64 <= n; i += 64) {
+            const __m256i a = lookup128_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), rows);
+            const __m256i b = lookup128_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 32)), rows);
+            if (_mm256_movemask_epi8(_mm256_or_si256(a, b)))
+                break;
+            const __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(a, pairs), _mm256_maddubs_epi16(b, pairs));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 2), _mm256_permute4x64_epi64(bytes, 0xD8));
+        }
+        return i + decode16_sse41(in + i, n - i, out + i / 2, t);
+    }
+
+    // 20 input bytes -> 32 output chars per iteration (reads 26 bytes); see encode32_sse41
+    CT_BASE64_TARGET("avx2")
+    inline size_t encode32_avx2(const uint8_t* in, size_t n, char* out, const Tables& t) {
+        const __m256i dict_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.dict)));
+        const __m256i dict_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.dict + 16)));
+        const __m256i shuf0 = _mm256_setr_epi8(1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4,
+                                               1, 0, 1, 0, 2, 1, 2, 1, 3, 2, 4, 3, 4, 3, 5, 4);
+        const __m256i shuf1 = _mm256_add_epi8(shuf0, _mm256_set1_epi8(5));
+        const __m256i shift = _mm256_setr_epi16(1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8,
+                                                1 << 5, 1 << 10, 1 << 7, 1 << 12, 1 << 9, 1 << 6, 1 << 11, 1 << 8);
+        const __m256i mask = _mm256_set1_epi16(0x1F);
+        size_t i = 0;
+        for (; i + 26 <= n; i += 20) {
+            // groups 0-1 | 2-3, then the words of groups 0 | 2 and 1 | 3
+            const __m256i v = load_lanes_avx2(in + i, in + i + 10);
+            const __m256i a = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(v, shuf0), shift), mask);
+            const __m256i b = _mm256_and_si256(_mm256_mulhi_epu16(_mm256_shuffle_epi8(v, shuf1), shift), mask);
+            const __m256i idx = _mm256_packus_epi16(a, b);
+            const __m256i chars = _mm256_blendv_epi8(_mm256_shuffle_epi8(dict_lo, idx), _mm256_shuffle_epi8(dict_hi, idx),
+                                                     _mm256_cmpgt_epi8(idx, _mm256_set1_epi8(15)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i / 5 * 8), chars);
+        }
+        return i / 5 * 8 + encode32_sse41(in + i, n - i, out + i / 5 * 8, t);
+    }
+
+    // 32 input chars -> 20 output bytes per iteration (writes 26 bytes); see decode32_sse41
+    CT_BASE64_TARGET("avx2")
+    inline size_t decode32_avx2(const char* in, size_t n, uint8_t* out, const Tables& t) {
+        const Lut256 rows = lut128_avx2(t.index);
+        const __m256i shuf = _mm256_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1,
+                                              4, 3, 2, 1, 0, 12, 11, 10, 9, 8, -1, -1, -1, -1, -1, -1);
+        size_t i = 0;
+        for (; i + 48 <= n; i += 32) {
+            const __m256i idx = lookup128_avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), rows);
+            if (_mm256_movemask_epi8(idx))
+                break;
+            const __m256i w = _mm256_maddubs_epi16(idx, _mm256_set1_epi16(0x0120));
+            const __m256i d = _mm256_madd_epi16(w, _mm256_set1_epi32(0x00010400));
+            const __m256i s = _mm256_or_si256(_mm256_slli_epi64(d, 20), _mm256_srli_epi64(d, 32));
+            const __m256i bytes = _mm256_shuffle_epi8(s, shuf);
+            uint8_t* dst = out + i / 8 * 5;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(bytes));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 10), _mm256_extracti128_si256(bytes, 1));
+        }
+        return i + decode32_sse41(in + i, n - i, out + i / 8 * 5, t);
+    }
+#endif // CT_BASE64_X86
+
+    //////////// Dispatch ////////////
+
+    // AVX-512 VBMI adds nothing over AVX2 here
+    template<>
+    struct tier_kernels<4> {
+        template<class A>
+        static Kernels of(Tier tier) {
+#ifdef CT_BASE64_X86
+            if (tier >= Tier::avx2)  return { Tier::avx2, encode16_avx2, decode16_avx2, compact_avx2, validate_scalar };
+            if (tier >= Tier::sse41) return { Tier::sse41, encode16_sse41, decode16_sse41, compact_sse41, validate_scalar };
+#endif
+            return scalar_kernels<4>();
+        }
+    };
+
+    template<>
+    struct tier_kernels<5> {
+        template<class A>
+        static Kernels of(Tier tier) {
+#ifdef CT_BASE64_X86
+            if (tier >= Tier::avx2)  return { Tier::avx2, encode32_avx2, decode32_avx2, compact_avx2, validate_scalar };
+            if (tier >= Tier::sse41) return { Tier::sse41, encode32_sse41, decode32_sse41, compact_sse41, validate_scalar };
+#endif
+            return scalar_kernels<5>();
+        }
+    };
+}
+}
+
+#endif // CT_RADIX_HPP
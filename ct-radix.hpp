@@ -0,0 +1,170 @@
+/**
+ * Compile-time lib
+ * @file    ct-radix.hpp
+ * @brief   Compile-time Base32/Base16 encoders/decoders on a generic radix codec (with a SIMD runtime codec)
+ * @author  Douglas Oliveira
+ * @date    2026-10-16
+ *
+ * Any alphabet of 16, 32 or 64 symbols: the bytes are cut into groups of lcm(8, bits) bits, written as
+ * 8 / gcd(8, bits) symbols (1 byte -> 2 chars for Base16, 5 bytes -> 8 chars for Base32). The tables,
+ * checks and codecs are the ones of ct-base64.hpp, BasicBase64 being the 6-bit instance; this header adds
+ * the SIMD kernels of the 4 and 5-bit alphabets to its dispatch (CT_BASE64_TIER applies here too).
+ *
+ * @note !!C++14 dependent module!!
+ */
+
+#ifndef CT_RADIX_HPP
+#define CT_RADIX_HPP
+
+#include "ct-base64-runtime.hpp"
+
+namespace ct
+{
+
+// radix alphabet policies: symbols() returns the 16 or 32 symbols in index order, aliases() optional
+// pairs of (char, symbol it decodes as), for case-insensitive or lenient decoding
+namespace alphabet
+{
+    // RFC 4648 base32
+    struct Base32 {
+        static constexpr const b64char* symbols() { return "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567"; }
+    };
+    // RFC 4648 base32hex, sorts like the data it encodes
+    struct Base32Hex {
+        static constexpr const b64char* symbols() { return "0123456789ABCDEFGHIJKLMNOPQRSTUV"; }
+    };
+    // Crockford's base32: no I, L, O, U; decoding ignores case and reads I and L as 1, O as 0
+    struct Crockford {
+        static constexpr const b64char* symbols() { return "0123456789ABCDEFGHJKMNPQRSTVWXYZ"; }
+        static constexpr const b64char* aliases() {
+            return "aAbBcCdDeEfFgGhHjJkKmMnNpPqQrRsStTvVwWxXyYzZi1I1l1L1o0O0";
+        }
+    };
+    // RFC 4648 base16, lower case out, either case in
+    struct Hex {
+        static constexpr const b64char* symbols() { return "0123456789abcdef"; }
+        static constexpr const b64char* aliases() { return "AaBbCcDdEeFf"; }
+    };
+    // RFC 4648 base16, upper case out, either case in
+    struct HexUpper {
+        static constexpr const b64char* symbols() { return "0123456789ABCDEF"; }
+        static constexpr const b64char* aliases() { return "aAbBcCdDeEfF"; }
+    };
+}
+
+// With padding the last group is filled up with '=' to a whole group; without, it is cut to the chars
+// its bytes need and '=' is never accepted
+template <class Alphabet, bool Padding = true>
+struct BasicRadix {
+    static_assert(impl::tables_of<Alphabet>::value.valid && impl::tables_of<Alphabet>::value.ascii,
+                  "BasicRadix: the alphabet needs 16, 32 or 64 distinct ASCII symbols other than '='");
+
+    typedef Alphabet alphabet_type;
+    static constexpr bool padding = Padding;
+    // bits per symbol, and the bytes and chars of a whole group
+    static constexpr unsigned bits = impl::tables_of<Alphabet>::value.bits;
+    static constexpr size_t group_bytes = impl::tables_of<Alphabet>::value.group_bytes;
+    static constexpr size_t group_chars = impl::tables_of<Alphabet>::value.group_chars;
+
+    // return a compile-time string
+    template <char... str>
+    static constexpr auto encode(ct::string<str...> s);
+    // return a compile-time string holding the exact payload
+    template <char... str>
+    static constexpr auto decode(ct::string<str...> s);
+    // return a compile-time byte string holding the exact payload
+    template <char... str>
+    static constexpr auto decode_bytes(ct::string<str...> s);
+
+    static constexpr size_t npos = size_t(-1);
+
+    // chars written by the runtime encoder for @p size bytes
+    static constexpr size_t encoded_size(size_t size) {
+        return impl::encoded_length(bits, size, Padding);
+    }
+    // bytes the runtime decoder may write for @p size chars (exact unless the input is padded)
+    static constexpr size_t decoded_max_size(size_t size) {
+        return size / group_chars * group_bytes + size % group_chars * bits / 8;
+    }
+
+    // runtime encoder, same output as the compile-time one
+    // @p out must have room for encoded_size(size) chars; returns the number of chars written
+    static size_t encode(const void* data, size_t size, char* out);
+    // runtime decoder, accepts the same inputs as the compile-time one
+    // @p out must have room for decoded_max_size(size) bytes; returns the number of bytes written, or npos
+    // if @p text is not a valid encoding, in which case the offset of the first bad char is stored in @p error
+    static size_t decode(const char* text, size_t size, void* out, size_t* error = nullptr);
+
+    // append to @p out, grown once to the final size; return the number of chars or bytes appended,
+    // or npos (@p out left as it was) if @p text is not a valid encoding
+    static size_t encode(const void* data, size_t size, std::string& out);
+    static size_t decode(const char* text, size_t size, std::string& out, size_t* error = nullptr);
+
+    // runtime kernel tier used for this alphabet: "scalar", "sse4.1" or "avx2"
+    static const char* tier();
+    // checks every tier the host supports against the compile-time results
+    static bool self_test();
+};
+
+typedef BasicRadix<alphabet::Base32>           Base32;
+typedef BasicRadix<alphabet::Base32Hex>        Base32Hex;
+typedef BasicRadix<alphabet::Crockford, false> Base32Crockford;
+typedef BasicRadix<alphabet::Hex, false>       Base16;
+typedef BasicRadix<alphabet::HexUpper, false>  Base16Upper;
+
+template <class A, bool P>
+template <char... str>
+constexpr auto BasicRadix<A, P>::encode(ct::string<str...> s) {
+    return impl::CTEncoder<A, P, str...>::encoded_string;
+}
+
+template <class A, bool P>
+template <char... str>
+constexpr auto BasicRadix<A, P>::decode(ct::string<str...> s) {
+    return impl::CTDecoder<A, P, false, str...>::decoded_string;
+}
+
+template <class A, bool P>
+template <char... str>
+constexpr auto BasicRadix<A, P>::decode_bytes(ct::string<str...> s) {
+    static_assert(impl::checks::is_encoding_v<A, P, str...>, "Input string is not a valid radix encoding");
+    return impl::decode_bytes<A, str...>(std::make_index_sequence<impl::decoded_size<A, str...>()>());
+}
+
+#include "ct-radix-rt.h"
+
+template <class A, bool P>
+inline size_t BasicRadix<A, P>::encode(const void* data, size_t size, char* out) {
+    const impl::Tables& t = impl::tables_of<A>::value;
+    return impl::rt::encode(impl::rt::kernels<A>(), t, P, static_cast<const uint8_t*>(data), size, out);
+}
+
+template <class A, bool P>
+inline size_t BasicRadix<A, P>::decode(const char* text, size_t size, void* out, size_t* error) {
+    const impl::Tables& t = impl::tables_of<A>::value;
+    return impl::rt::decode(impl::rt::kernels<A>(), t, P, text, size, static_cast<uint8_t*>(out), error);
+}
+
+template <class A, bool P>
+inline size_t BasicRadix<A, P>::encode(const void* data, size_t size, std::string& out) {
+    return impl::rt::append(out, encoded_size(size), [&](char* dst) { return encode(data, size, dst); });
+}
+
+template <class A, bool P>
+inline size_t BasicRadix<A, P>::decode(const char* text, size_t size, std::string& out, size_t* error) {
+    return impl::rt::append(out, decoded_max_size(size), [&](char* dst) { return decode(text, size, dst, error); });
+}
+
+template <class A, bool P>
+inline const char* BasicRadix<A, P>::tier() {
+    return impl::rt::tier_names[int(impl::rt::kernels<A>().tier)];
+}
+
+template <class A, bool P>
+inline bool BasicRadix<A, P>::self_test() {
+    return impl::rt::run_tables_self_test<BasicRadix>(impl::rt::TablesSelfTest<A, P>());
+}
+
+}
+
+#endif // CT_RADIX_HPP
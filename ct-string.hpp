@@ -12,12 +12,18 @@
 #ifndef CT_STRING_HPP
 #define CT_STRING_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <utility>
+
 // Call this to create a compile-time string from a literal
-#define CTSTRING(string_literal)                                                       \
-    []{                                                                                \
-        struct constexpr_string_type { const char * data = string_literal; };         \
-        return ct::toolbox::apply_range<sizeof(string_literal)-1,                 \
-            ct::toolbox::string_builder<constexpr_string_type>::produce>::result{};   \
+#define CTSTRING(string_literal)                                                             \
+    []{                                                                                      \
+        struct constexpr_string_type { const char * data = string_literal; };                \
+        return typename ct::toolbox::apply_range<sizeof(string_literal)-1,                   \
+            ct::toolbox::string_builder<constexpr_string_type>::template produce>::result{}; \
     }()
 
 namespace ct
@@ -27,6 +33,9 @@ template<char... str>
 struct string
 {
     static constexpr const char data[sizeof...(str)+1] = {str..., '\0'};
+
+    // length without the trailing '\0', data may hold embedded '\0's
+    static constexpr size_t size() { return sizeof...(str); }
 };
 
 // concat operator
@@ -36,29 +45,45 @@ constexpr string<str0..., str1...> operator+(string<str0...>, string<str1...>)
     return {};
 }
 
-// print operator
-template<char... str>
-std::ostream& operator << (std::ostream& out, string<str...> s) {
-    return (out << s.data);
+// print operator, writes every char (embedded '\0's included)
+template<class Char, class Traits, char... str>
+std::basic_ostream<Char, Traits>& operator << (std::basic_ostream<Char, Traits>& out, string<str...> s) {
+    return out.write(s.data, sizeof...(str));
 }
 
 template<char... str>
 constexpr const char string<str...>::data[sizeof...(str)+1];
 
+// binary counterpart of ct::string: no trailing '\0', data holds exactly size() bytes
+template<uint8_t... bytes_>
+struct bytes
+{
+    static constexpr std::array<uint8_t, sizeof...(bytes_)> data = {{bytes_...}};
+
+    static constexpr size_t size() { return sizeof...(bytes_); }
+};
+
+template<uint8_t... bytes_>
+constexpr std::array<uint8_t, sizeof...(bytes_)> bytes<bytes_...>::data;
+
 namespace toolbox
 {
-    template<unsigned count, template<unsigned...> class meta_functor, unsigned... indices>
-    struct apply_range
-    {
-        typedef typename apply_range<count-1, meta_functor, count-1, indices...>::result result;
-    };
+    template<template<unsigned...> class meta_functor, typename sequence>
+    struct apply_sequence;
 
     template<template<unsigned...> class meta_functor, unsigned... indices>
-    struct apply_range<0, meta_functor, indices...>
+    struct apply_sequence<meta_functor, std::integer_sequence<unsigned, indices...> >
     {
         typedef typename meta_functor<indices...>::result result;
     };
 
+    // meta_functor<0, 1, ..., count-1>::result, the index pack is built in a single instantiation
+    template<unsigned count, template<unsigned...> class meta_functor>
+    struct apply_range
+    {
+        typedef typename apply_sequence<meta_functor, std::make_integer_sequence<unsigned, count> >::result result;
+    };
+
     template<typename lambda_str_type>
     struct string_builder
     {
@@ -68,6 +93,15 @@ namespace toolbox
             typedef string<lambda_str_type{}.data[indices]...> result;
         };
     };
+
+    // lifts the chars of the constexpr array returned by make() into a string; the array is kept
+    // in a local constant so that reading each element stays cheap
+    template<typename array, array (*make)(), unsigned... indices>
+    constexpr auto lift_array(std::integer_sequence<unsigned, indices...>)
+    {
+        constexpr array a = make();
+        return string<a.data[indices]...>();
+    }
 }
 
 }